@@ -0,0 +1,283 @@
+﻿// Benchmark quét kích thước bảng từ vừa L1 đến nhiều lần LLC: mỗi loại bảng, mỗi load factor,
+// đo ns/op cho search HIT, search MISS, insert và erase để thấy điểm rơi khỏi từng tầng cache
+#define DOUBLE_HASHING_NO_MAIN
+#include "main.cpp"
+
+#include <fstream>
+
+namespace CacheSweep {
+    // Dung lượng các tầng cache (byte) của core 0
+    struct CacheSizes {
+        long long l1 = 32 << 10;
+        long long l2 = 1 << 20;
+        long long l3 = 32 << 20;
+    };
+
+    // Đọc từ sysfs trên Linux; không đọc được thì giữ giá trị mặc định
+    CacheSizes detectCacheSizes() {
+        CacheSizes sizes;
+        for (int index = 0; index < 8; ++index) {
+            std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+            std::ifstream levelFile(dir + "level"), typeFile(dir + "type"), sizeFile(dir + "size");
+            int level;
+            std::string type, size;
+            if (!(levelFile >> level) || !(typeFile >> type) || !(sizeFile >> size) || type == "Instruction")
+                continue;
+
+            long long bytes = std::stoll(size);
+            char unit = size.back();
+            if (unit == 'K') bytes <<= 10;
+            else if (unit == 'M') bytes <<= 20;
+            if (level == 1) sizes.l1 = bytes;
+            else if (level == 2) sizes.l2 = bytes;
+            else if (level == 3) sizes.l3 = bytes;
+        }
+        return sizes;
+    }
+
+    std::string cacheLevel(long long bytes, const CacheSizes& caches) {
+        if (bytes <= caches.l1) return "L1";
+        if (bytes <= caches.l2) return "L2";
+        if (bytes <= caches.l3) return "L3";
+        return "DRAM";
+    }
+
+    struct Options {
+        long long minBytes = 16 << 10;
+        long long maxBytes = 0;  // 0 = 4 * LLC, tối đa 1 GiB
+        std::vector<double> loadFactors = { 0.5, 0.7, 0.9 };
+        std::vector<std::string> algorithms;  // rỗng = tất cả
+        uint64_t seed = BenchmarkUtils::generator::DEFAULT_SEED;
+        int maxQueries = 1 << 20;
+        std::string format = "csv";
+        BenchmarkUtils::measure::Config measure{ 1, 3, 10, 0.05 };
+    };
+
+    struct Row {
+        int tableSize;
+        int keys;
+        PhaseStats hit, miss, insert, erase;
+    };
+
+    // Key lẻ cho HIT, key chẵn cho MISS: không cần tập hợp để loại trùng,
+    // thứ tự truy cập được xáo trộn nên mọi lần probe rơi vào vị trí ngẫu nhiên của bảng
+    template <typename Table>
+    Row sweepOne(int slots, double lf, int maxQueries, const BenchmarkUtils::measure::Config& cfg) {
+        using BenchmarkUtils::measure::elapsedNs;
+        Table empty(slots);
+        Row row;
+        row.tableSize = empty.size();
+        row.keys = std::max(1, int(lf * row.tableSize));
+
+        std::mt19937 rng = BenchmarkUtils::generator::makeRng();
+        std::vector<int> keys(row.keys);
+        for (int i = 0; i < row.keys; ++i) keys[i] = 2 * i + 1;
+        std::shuffle(keys.begin(), keys.end(), rng);
+
+        int numQueries = std::min(row.keys, maxQueries);
+        std::uniform_int_distribution<int> pick(0, row.keys - 1);
+        std::vector<int> hitKeys(numQueries), missKeys(numQueries);
+        for (int i = 0; i < numQueries; ++i) {
+            hitKeys[i] = keys[pick(rng)];
+            missKeys[i] = 2 * pick(rng);
+        }
+
+        // Insert và erase thay đổi bảng: mỗi lần đo bắt đầu từ một bảng rỗng mới
+        std::vector<double> insertNs, eraseNs;
+        for (int rep = 0; rep < cfg.warmup + cfg.maxReps; ++rep) {
+            Table table(empty);
+            double tInsert = elapsedNs([&] {
+                for (int key : keys) table.insert(key, key);
+            });
+            double tErase = elapsedNs([&] {
+                for (int key : keys) table.erase(key);
+            });
+            if (rep < cfg.warmup) continue;
+            insertNs.push_back(tInsert);
+            eraseNs.push_back(tErase);
+            if (BenchmarkUtils::measure::converged(insertNs, cfg) && BenchmarkUtils::measure::converged(eraseNs, cfg))
+                break;
+        }
+        row.insert = BenchmarkUtils::measure::summarize(insertNs, row.keys);
+        row.erase = BenchmarkUtils::measure::summarize(eraseNs, row.keys);
+
+        Table table(empty);
+        for (int key : keys) table.insert(key, key);
+        volatile int sink = 0;
+        row.hit = BenchmarkUtils::measure::run(numQueries, [&] {
+            int v;
+            for (int key : hitKeys)
+                if (table.search(key, v)) sink = v;
+        }, cfg);
+        row.miss = BenchmarkUtils::measure::run(numQueries, [&] {
+            int v;
+            for (int key : missKeys)
+                if (table.search(key, v)) sink = v;
+        }, cfg);
+        (void)sink;
+        return row;
+    }
+
+    struct Algorithm {
+        std::string name;
+        std::string label;
+        double bytesPerSlot;  // để quy kích thước byte mục tiêu ra số slot và số slot thật ra byte
+        std::function<Row(int, double, int, const BenchmarkUtils::measure::Config&)> run;
+    };
+
+    const std::vector<Algorithm>& registry() {
+        constexpr double AOS = sizeof(Entry<int, int>);
+        constexpr double SOA = 1 + sizeof(int) + sizeof(int);
+        constexpr double BUCKET = double(sizeof(CacheLineBucket<int, int>)) / CacheLineBucket<int, int>::SLOTS;
+        static const std::vector<Algorithm> algorithms = {
+            { "double", "Double Hashing", AOS, sweepOne<DoubleHashTable<int, int>> },
+            { "linear", "Linear Probing", AOS, sweepOne<LinearHashTable<int, int>> },
+            { "quadratic", "Quadratic Probing", AOS, sweepOne<QuadraticHashTable<int, int>> },
+            { "group", "Group Double SIMD", SOA, sweepOne<GroupDoubleHashTable<int, int>> },
+            { "soa", "Double Hash (SoA)", SOA, sweepOne<DoubleHashTable<int, int, SoASlots>> },
+            { "pow2", "Double Hash (Pow2)", AOS, sweepOne<DoubleHashTable<int, int, AoSSlots, Pow2Sizing>> },
+            { "robinhood", "Robin Hood Double", double(sizeof(RobinHoodEntry<int, int>)), sweepOne<RobinHoodHashTable<int, int>> },
+            { "cuckoo", "Bucketized Cuckoo", BUCKET, sweepOne<CuckooHashTable<int, int>> },
+            { "hopscotch", "Hopscotch", double(sizeof(HopscotchEntry<int, int>)), sweepOne<HopscotchHashTable<int, int>> },
+            { "bucket-double", "Bucketized Double", BUCKET, sweepOne<BucketDoubleHashTable<int, int>> },
+        };
+        return algorithms;
+    }
+
+    void printUsage(const char* prog) {
+        std::cerr << "Usage: " << prog << " [options]\n"
+            << "  --min-kb K             smallest table footprint (default 16)\n"
+            << "  --max-mb M             largest table footprint (default 4 x LLC, at most 1024)\n"
+            << "  --lf A[,B...]          load factors (default 0.5,0.7,0.9)\n"
+            << "  --algorithms A[,...]   ";
+        for (size_t i = 0; i < registry().size(); ++i)
+            std::cerr << (i ? "," : "") << registry()[i].name;
+        std::cerr << " (default all)\n"
+            << "  --queries Q            max lookups per search measurement (default 1048576)\n"
+            << "  --seed S               random seed (default " << BenchmarkUtils::generator::DEFAULT_SEED << ")\n"
+            << "  --format csv|json      output format (default csv)\n";
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opts, std::string& error) {
+        for (int i = 1; i < argc; ++i) {
+            std::string flag = argv[i];
+            std::string value;
+            size_t eq = flag.find('=');
+            if (eq != std::string::npos) {
+                value = flag.substr(eq + 1);
+                flag = flag.substr(0, eq);
+            }
+            else if (flag == "--help") {
+                error.clear();
+                return false;
+            }
+            else if (i + 1 < argc) {
+                value = argv[++i];
+            }
+            else {
+                error = "missing value for " + flag;
+                return false;
+            }
+
+            try {
+                if (flag == "--min-kb") opts.minBytes = std::stoll(value) << 10;
+                else if (flag == "--max-mb") opts.maxBytes = std::stoll(value) << 20;
+                else if (flag == "--queries") opts.maxQueries = std::stoi(value);
+                else if (flag == "--seed") opts.seed = std::stoull(value);
+                else if (flag == "--format") opts.format = value;
+                else if (flag == "--lf") {
+                    opts.loadFactors.clear();
+                    for (const auto& item : BenchmarkUtils::cli::splitList(value))
+                        opts.loadFactors.push_back(std::stod(item));
+                }
+                else if (flag == "--algorithms") {
+                    opts.algorithms = BenchmarkUtils::cli::splitList(value);
+                    for (const auto& name : opts.algorithms) {
+                        bool known = std::any_of(registry().begin(), registry().end(), [&](const Algorithm& a) { return a.name == name; });
+                        if (!known) {
+                            error = "unknown algorithm: " + name;
+                            return false;
+                        }
+                    }
+                }
+                else {
+                    error = "unknown option: " + flag;
+                    return false;
+                }
+            }
+            catch (const std::exception&) {
+                error = "invalid value for " + flag + ": " + value;
+                return false;
+            }
+        }
+
+        if (opts.minBytes <= 0) error = "--min-kb must be positive";
+        else if (opts.maxBytes < 0 || (opts.maxBytes && opts.maxBytes < opts.minBytes)) error = "--max-mb must be >= --min-kb";
+        else if (opts.loadFactors.empty()) error = "--lf needs at least one load factor";
+        else if (std::any_of(opts.loadFactors.begin(), opts.loadFactors.end(), [](double lf) { return lf <= 0 || lf > 0.95; }))
+            error = "load factors must be in (0, 0.95]";
+        else if (opts.maxQueries < 1) error = "--queries must be >= 1";
+        else if (opts.format != "csv" && opts.format != "json") error = "--format must be csv or json";
+        return error.empty();
+    }
+
+    int run(int argc, char** argv) {
+        using BenchmarkUtils::cli::num;
+        Options opts;
+        std::string error;
+        if (!parseArgs(argc, argv, opts, error)) {
+            if (!error.empty()) std::cerr << "error: " << error << "\n";
+            printUsage(argv[0]);
+            return error.empty() ? 0 : 2;
+        }
+        BenchmarkUtils::generator::setSeed(opts.seed);
+        if (!BenchmarkUtils::measure::pinToCore())
+            std::cerr << "warning: could not pin to a core, timings may be noisier\n";
+
+        CacheSizes caches = detectCacheSizes();
+        if (opts.maxBytes == 0) opts.maxBytes = std::min(4 * caches.l3, 1LL << 30);
+        std::cerr << "L1d " << (caches.l1 >> 10) << " KiB, L2 " << (caches.l2 >> 10) << " KiB, L3 " << (caches.l3 >> 10)
+            << " KiB; sweeping " << (opts.minBytes >> 10) << " KiB .. " << (opts.maxBytes >> 10) << " KiB\n";
+
+        BenchmarkUtils::cli::RecordWriter writer(opts.format == "json");
+        for (long long target = opts.minBytes; target <= opts.maxBytes; target *= 2) {
+            for (const Algorithm& algo : registry()) {
+                if (!opts.algorithms.empty() && std::find(opts.algorithms.begin(), opts.algorithms.end(), algo.name) == opts.algorithms.end())
+                    continue;
+                for (double lf : opts.loadFactors) {
+                    // Số slot nguyên tố như main: bảng tĩnh giữ đúng kích thước yêu cầu, nên kích thước
+                    // hợp số sẽ cho double hashing một dãy probe không phủ hết bảng
+                    int slots = helper::nextPrime(int(target / algo.bytesPerSlot));
+                    Row row = algo.run(slots, lf, opts.maxQueries, opts.measure);
+                    // Kích thước thật sau khi bảng làm tròn (nguyên tố, lũy thừa của 2, bội số bucket)
+                    long long bytes = std::llround(row.tableSize * algo.bytesPerSlot);
+                    std::vector<BenchmarkUtils::cli::Field> fields = {
+                        { "algorithm", algo.name, true },
+                        { "label", algo.label, true },
+                        { "load_factor", num(lf), false },
+                        { "target_bytes", num(target), false },
+                        { "table_bytes", num(bytes), false },
+                        { "cache_level", cacheLevel(bytes, caches), true },
+                        { "table_size", num(row.tableSize), false },
+                        { "keys", num(row.keys), false },
+                    };
+                    auto addPhase = [&](const std::string& name, const PhaseStats& ps) {
+                        fields.push_back({ name + "_ns_op", num(ps.nsPerOp), false });
+                        fields.push_back({ name + "_ci95_pct", num(100 * ps.relCI()), false });
+                    };
+                    addPhase("search_hit", row.hit);
+                    addPhase("search_miss", row.miss);
+                    addPhase("insert", row.insert);
+                    addPhase("erase", row.erase);
+                    writer.write(fields);
+                }
+            }
+        }
+        writer.finish();
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    return CacheSweep::run(argc, argv);
+}
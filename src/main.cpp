@@ -5,6 +5,48 @@
 #include <iomanip>
 #include <sstream>
 #include <unordered_set>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <algorithm>
+#include <cstdint>
+#include <bit>
+#include <type_traits>
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+#include <condition_variable>
+#include <deque>
+#include <latch>
+#include <cmath>
+#include <optional>
+#include <limits>
+#include <cerrno>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DOUBLE_HASHING_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
 
 enum SlotState { 
     EMPTY, 
@@ -21,32 +63,562 @@ struct Entry {
     Entry(const K& k, const V& v, SlotState s) : key(k), value(v), state(s) {}
 };
 
+// Slot của RobinHoodHashTable: thêm dist = số bước từ slot gốc trên dãy probe của key
+template<typename K, typename V>
+struct RobinHoodEntry {
+    K key;
+    V value;
+    int dist;
+    SlotState state;
+    RobinHoodEntry() : dist(0), state(EMPTY) {}
+};
+
+// Slot của HopscotchHashTable: hop là bitmap vùng lân cận của bucket có slot gốc là slot này
+// (bit i = 1 khi slot gốc + i chứa một key thuộc bucket này), nằm chung dòng cache với slot gốc
+template<typename K, typename V>
+struct HopscotchEntry {
+    K key;
+    V value;
+    uint32_t hop;
+    SlotState state;
+    HopscotchEntry() : hop(0), state(EMPTY) {}
+};
+
+// Bucket = một dòng cache 64 byte: mask chiếm chỗ + SLOTS cặp key/value.
+// overflow chỉ BucketDoubleHashTable dùng: số key đã đi qua bucket này khi nó đầy
+// Số slot theo kiểu key/value (tính cả padding căn lề): <int, int> -> 7, <long long, int> -> 4,
+// <long long, long long> -> 3, value 40 byte -> 1. Bucket dưới MIN_WIDE_SLOTS là bucket hẹp:
+// bảng nào cần bucket rộng thì static_assert trên MIN_WIDE_SLOTS
+template<typename K, typename V>
+struct CacheLineBucket {
+    static constexpr int MIN_WIDE_SLOTS = 4;
+
+    // Số slot lớn nhất (tối đa 8 cho mask 1 byte) để 2 byte mask + keys + values vừa 64 byte
+    static constexpr int fitSlots() {
+        auto alignUp = [](size_t off, size_t a) { return (off + a - 1) / a * a; };
+        for (int s = 8; s > 1; --s) {
+            size_t off = alignUp(2, alignof(K)) + s * sizeof(K);
+            off = alignUp(off, alignof(V)) + s * sizeof(V);
+            if (off <= 64)
+                return s;
+        }
+        return 1;
+    }
+
+    static constexpr int SLOTS = fitSlots();
+    static constexpr uint8_t FULL = uint8_t((1u << SLOTS) - 1);
+
+    alignas(64) uint8_t occupied = 0;  // bit i = 1 khi slot i có key
+    uint8_t overflow = 0;
+    K keys[SLOTS];
+    V values[SLOTS];
+
+    bool full() const {
+        return occupied == FULL;
+    }
+
+    // Slot chứa key, -1 nếu không có. Key số nguyên: so cả bucket không rẽ nhánh
+    // (compiler vector hóa được), tránh đoán sai nhánh ở mỗi slot
+    int find(const K& key) const {
+        if constexpr (std::is_integral_v<K>) {
+            uint32_t match = 0;
+            for (int i = 0; i < SLOTS; ++i)
+                match |= uint32_t(keys[i] == key) << i;
+            match &= occupied;
+            return match ? std::countr_zero(match) : -1;
+        }
+        else {
+            for (uint32_t m = occupied; m; m &= m - 1) {
+                int i = std::countr_zero(m);
+                if (keys[i] == key) return i;
+            }
+            return -1;
+        }
+    }
+
+    int freeSlot() const {
+        return std::countr_one(static_cast<uint32_t>(occupied));
+    }
+};
+
+// Gợi ý CPU nạp trước dòng cache chứa p; không đổi kết quả, chỉ che độ trễ bộ nhớ
+inline void prefetchRead(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 0, 3);
+#elif defined(DOUBLE_HASHING_SSE2) || defined(__AVX2__)
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+    (void)p;
+#endif
+}
+
+// ======= Slot layouts =======
+// AoS: mỗi slot là một Entry (key, value, state) nằm liền nhau
+template<typename K, typename V>
+struct AoSSlots {
+    std::vector<Entry<K, V>> entries;
+
+    void assign(int n) { entries.assign(n, Entry<K, V>()); }
+    SlotState state(int i) const { return entries[i].state; }
+    const K& key(int i) const { return entries[i].key; }
+    const V& value(int i) const { return entries[i].value; }
+    void set(int i, const K& k, const V& v) { entries[i] = Entry<K, V>(k, v, OCCUPIED); }
+    void setValue(int i, const V& v) { entries[i].value = v; }
+    void markDeleted(int i) { entries[i].state = DELETED; }
+    void setState(int i, SlotState s) { entries[i].state = s; }
+    void move(int from, int to) {
+        entries[to] = std::move(entries[from]);
+        entries[to].state = OCCUPIED;
+        entries[from].state = EMPTY;
+    }
+    void swap(int i, int j) { std::swap(entries[i], entries[j]); }
+    void prefetch(int i) const { prefetchRead(&entries[i]); }
+    const std::vector<Entry<K, V>>& states() const { return entries; }
+};
+
+// SoA: state (1 byte), key, value nằm ở 3 mảng riêng,
+// vòng probe chỉ chạm vào state và key cho đến khi tìm thấy
+template<typename K, typename V>
+struct SoASlots {
+    std::vector<uint8_t> stateArr;
+    std::vector<K> keys;
+    std::vector<V> values;
+
+    void assign(int n) {
+        stateArr.assign(n, EMPTY);
+        keys.assign(n, K());
+        values.assign(n, V());
+    }
+    SlotState state(int i) const { return SlotState(stateArr[i]); }
+    const K& key(int i) const { return keys[i]; }
+    const V& value(int i) const { return values[i]; }
+    void set(int i, const K& k, const V& v) {
+        keys[i] = k;
+        values[i] = v;
+        stateArr[i] = OCCUPIED;
+    }
+    void setValue(int i, const V& v) { values[i] = v; }
+    void markDeleted(int i) { stateArr[i] = DELETED; }
+    void setState(int i, SlotState s) { stateArr[i] = s; }
+    void move(int from, int to) {
+        keys[to] = std::move(keys[from]);
+        values[to] = std::move(values[from]);
+        stateArr[to] = OCCUPIED;
+        stateArr[from] = EMPTY;
+    }
+    void swap(int i, int j) {
+        std::swap(keys[i], keys[j]);
+        std::swap(values[i], values[j]);
+        std::swap(stateArr[i], stateArr[j]);
+    }
+    void prefetch(int i) const {
+        prefetchRead(&stateArr[i]);
+        prefetchRead(&keys[i]);
+    }
+    const std::vector<uint8_t>& states() const { return stateArr; }
+};
+
+namespace TombstoneUtils {
+    // Tỷ lệ tombstone trên TABLE_SIZE kích hoạt dọn dẹp tự động
+    constexpr double MAX_TOMBSTONE_RATIO = 0.2;
+
+    // Dọn tombstone tại chỗ, không cấp phát mảng mới (giống DropDeletesWithoutResize của Abseil):
+    // DELETED -> EMPTY, OCCUPIED -> DELETED (đánh dấu "chờ đặt lại"), sau đó đặt từng entry
+    // vào slot đầu tiên không OCCUPIED trên dãy probe của nó; nếu slot đó cũng đang chờ thì hoán đổi.
+    // firstFree(key) trả về slot đầu tiên có state != OCCUPIED trên dãy probe của key, -1 nếu
+    // không có; dãy probe phải đi qua mọi slot, nếu không có thể không còn slot nào để đặt lại
+    // entry. Khi đó trả về false và dừng giữa chừng: entry OCCUPIED và DELETED ("chờ đặt lại")
+    // đều còn sống nhưng chuỗi probe đã hỏng, caller phải dựng lại bảng từ cả hai loại
+    template<typename Slots, typename FirstFree>
+    bool compactInPlace(Slots& slots, int n, FirstFree firstFree) {
+        for (int i = 0; i < n; ++i) {
+            SlotState st = slots.state(i);
+            if (st == DELETED) slots.setState(i, EMPTY);
+            else if (st == OCCUPIED) slots.setState(i, DELETED);
+        }
+        for (int i = 0; i < n; ++i) {
+            if (slots.state(i) != DELETED) continue;
+            int target = firstFree(slots.key(i));
+            if (target < 0)
+                return false;
+            if (target == i) {
+                slots.setState(i, OCCUPIED);
+            }
+            else if (slots.state(target) == EMPTY) {
+                slots.move(i, target);
+            }
+            else {
+                slots.swap(i, target);
+                slots.setState(target, OCCUPIED);
+                --i;  // entry vừa đổi về slot i cũng đang chờ đặt lại
+            }
+        }
+        return true;
+    }
+}
+
+enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_EVENT_COUNT
+};
+
+inline const char* const PERF_EVENT_NAMES[PERF_EVENT_COUNT] = { "cycles", "instructions", "l1d_misses", "llc_misses", "dtlb_misses", "branch_misses" };
+
+// Bộ đếm phần cứng cộng dồn qua các lần đo của một pha; -1 = event không đọc được
+struct PerfCounts {
+    long long value[PERF_EVENT_COUNT];
+    long long ops = 0;
+
+    PerfCounts() {
+        std::fill(std::begin(value), std::end(value), -1LL);
+    }
+
+    void add(const PerfCounts& sample, long long sampleOps) {
+        for (int e = 0; e < PERF_EVENT_COUNT; ++e)
+            if (sample.value[e] >= 0)
+                value[e] = std::max(0LL, value[e]) + sample.value[e];
+        ops += sampleOps;
+    }
+
+    bool valid(int e) const {
+        return value[e] >= 0 && ops > 0;
+    }
+
+    double perOp(int e) const {
+        return valid(e) ? double(value[e]) / ops : -1;
+    }
+};
+
+// Tổng hợp các lần đo của một pha, đơn vị nanoseconds cho toàn pha
+struct PhaseStats {
+    double medianNs = 0;
+    double minNs = 0;
+    double meanNs = 0;
+    double stddevNs = 0;
+    double ci95Ns = 0;   // nửa độ rộng khoảng tin cậy 95% của mean
+    double nsPerOp = 0;  // median chia số thao tác
+    long long ops = 0;   // số thao tác trong một lần đo
+    int samples = 0;
+    PerfCounts perf;
+
+    double relCI() const { return meanNs > 0 ? ci95Ns / meanNs : 0; }
+};
+
 struct StatResult {
-    // đơn vị: microseconds
+    // đơn vị: microseconds (median các lần đo)
     long long insertTime;
     long long searchTime;
     long long deleteTime;
+    long long batchSearchTime;  // search_batch trên cùng tập key HIT + MISS, -1 nếu bảng không hỗ trợ
+    long long insertAfterDeleteTime;
     double avgProbeSearchHit;
     double avgProbeSearchMiss;
     double avgProbeInsertAfterDelete;
+    double avgProbeSearchMissAfterChurn;  // search miss sau chu kỳ delete + insert lại
+
+    // Phân bố thời gian từng pha
+    PhaseStats insertPhase;
+    PhaseStats searchHitPhase;
+    PhaseStats searchMissPhase;
+    PhaseStats deletePhase;
+    PhaseStats insertAfterDeletePhase;
+    PhaseStats batchSearchPhase;
+    int runs;  // số lần đo (không tính warmup)
+};
+
+// Histogram chia theo lũy thừa 2, mỗi khoảng [2^k, 2^(k+1)) chia đều thành HALF bucket
+// (kiểu HdrHistogram): sai số tương đối <= 1/HALF, số bucket cố định cho mọi giá trị 64 bit
+class LogHistogram {
+public:
+    static constexpr int SUB_BITS = 5;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;  // giá trị < SUB_BUCKETS được đếm chính xác
+    static constexpr int HALF = SUB_BUCKETS / 2;
+    static constexpr int BUCKETS = SUB_BUCKETS + (64 - SUB_BITS) * HALF;
+
+private:
+    std::vector<uint64_t> counts;  // cấp phát ở lần record đầu tiên
+    uint64_t total = 0;
+    uint64_t minValue = UINT64_MAX;
+    uint64_t maxValue = 0;
+    double sum = 0;
+
+public:
+    static int bucketOf(uint64_t v) {
+        if (v < SUB_BUCKETS) return static_cast<int>(v);
+        int shift = std::bit_width(v) - SUB_BITS;
+        return SUB_BUCKETS + (shift - 1) * HALF + static_cast<int>(v >> shift) - HALF;
+    }
+
+    // Giá trị lớn nhất rơi vào bucket b
+    static uint64_t bucketHigh(int b) {
+        if (b < SUB_BUCKETS) return b;
+        int shift = (b - SUB_BUCKETS) / HALF + 1;
+        uint64_t top = (b - SUB_BUCKETS) % HALF + HALF;
+        return ((top + 1) << shift) - 1;
+    }
+
+    void record(uint64_t v, uint64_t n = 1) {
+        if (counts.empty()) counts.assign(BUCKETS, 0);
+        counts[bucketOf(v)] += n;
+        total += n;
+        sum += double(v) * n;
+        minValue = std::min(minValue, v);
+        maxValue = std::max(maxValue, v);
+    }
+
+    void merge(const LogHistogram& other) {
+        if (other.total == 0) return;
+        if (counts.empty()) counts.assign(BUCKETS, 0);
+        for (int b = 0; b < BUCKETS; ++b)
+            counts[b] += other.counts[b];
+        total += other.total;
+        sum += other.sum;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+
+    void reset() {
+        *this = LogHistogram();
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total ? minValue : 0; }
+    uint64_t max() const { return maxValue; }
+    double mean() const { return total ? sum / total : 0; }
+
+    // p trong [0, 100]; trả về cận trên của bucket chứa phân vị, không vượt quá max thực tế
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100 * total)));
+        uint64_t seen = 0;
+        for (int b = 0; b < BUCKETS; ++b) {
+            seen += counts[b];
+            if (seen >= rank)
+                return std::min(bucketHigh(b), maxValue);
+        }
+        return maxValue;
+    }
+};
+
+enum HistOp {
+    HIST_INSERT,
+    HIST_SEARCH_HIT,
+    HIST_SEARCH_MISS,
+    HIST_ERASE,
+    HIST_REHASH,  // đổi kích thước, compact tại chỗ, bắt đầu migration
+    HIST_OP_COUNT
+};
+
+inline const char* const HIST_OP_NAMES[HIST_OP_COUNT] = { "insert", "search_hit", "search_miss", "erase", "rehash" };
+
+// Độ trễ (ns) và số probe của từng thao tác
+struct OpHistograms {
+    LogHistogram latency[HIST_OP_COUNT];
+    LogHistogram probes[HIST_OP_COUNT];
+    int depth = 0;  // thao tác lồng nhau (insert bên trong rehash) chỉ tính ở lớp ngoài
+
+    void merge(const OpHistograms& other) {
+        for (int op = 0; op < HIST_OP_COUNT; ++op) {
+            latency[op].merge(other.latency[op]);
+            probes[op].merge(other.probes[op]);
+        }
+    }
 };
 
-struct HashStats {
-    int totalProbesInsert = 0;
-    int totalProbesSearch = 0;
-    int totalProbesDelete = 0;
-    int totalCollision = 0;
-    int nInsert = 0;
-    int nSearch = 0;
-    int nDelete = 0;
+// Kiểu bộ đếm quyết định giá của thống kê trên hot path
+namespace StatsPolicy {
+    // Bỏ qua mọi phép cộng, đọc luôn ra 0: compiler xoá hẳn các lệnh cập nhật
+    struct NullCounter {
+        NullCounter& operator+=(long long) { return *this; }
+        NullCounter& operator++() { return *this; }
+        void operator++(int) {}
+        operator long long() const { return 0; }
+    };
+
+    // Mỗi thread cộng vào ô riêng (mỗi ô một dòng cache) bằng atomic relaxed, đọc thì cộng
+    // mọi ô: nhiều thread cập nhật cùng bảng mà không data race và không tranh nhau dòng cache
+    class ShardedCounter {
+        static constexpr int SLOTS = 16;
+        struct alignas(64) Slot {
+            std::atomic<long long> v{ 0 };
+        };
+        Slot slots[SLOTS];
+
+        static int slotOfThisThread() {
+            static std::atomic<int> next{ 0 };
+            thread_local int slot = next.fetch_add(1, std::memory_order_relaxed) % SLOTS;
+            return slot;
+        }
+
+    public:
+        ShardedCounter() = default;
+
+        ShardedCounter(const ShardedCounter& other) {
+            *this = other;
+        }
+
+        ShardedCounter& operator=(const ShardedCounter& other) {
+            for (int i = 0; i < SLOTS; ++i)
+                slots[i].v.store(other.slots[i].v.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        ShardedCounter& operator+=(long long delta) {
+            slots[slotOfThisThread()].v.fetch_add(delta, std::memory_order_relaxed);
+            return *this;
+        }
+
+        ShardedCounter& operator++() {
+            return *this += 1;
+        }
+
+        void operator++(int) {
+            *this += 1;
+        }
+
+        operator long long() const {
+            long long total = 0;
+            for (const Slot& s : slots)
+                total += s.v.load(std::memory_order_relaxed);
+            return total;
+        }
+    };
+}
+
+// Thống kê của một bảng; Counter chọn chính sách: long long (mặc định, đơn luồng),
+// StatsPolicy::NullCounter (tắt hẳn) hoặc StatsPolicy::ShardedCounter (đa luồng)
+template<typename Counter>
+struct BasicHashStats {
+    static constexpr bool ENABLED = !std::is_same_v<Counter, StatsPolicy::NullCounter>;
+    // Histogram đọc bộ đếm probe ở mỗi thao tác và không an toàn đa luồng: chỉ bộ đếm thường
+    static constexpr bool HISTOGRAMS = std::is_same_v<Counter, long long>;
+
+    Counter totalProbesInsert{};
+    Counter totalProbesSearch{};
+    Counter totalProbesDelete{};
+    Counter totalCollision{};
+    Counter nInsert{};
+    Counter nSearch{};
+    Counter nDelete{};
+    Counter nCompact{};
+    Counter nResize{};
+
+    // Chỉ có khi gọi enableHistograms(): mỗi thao tác tốn thêm hai lần đọc đồng hồ
+    std::optional<OpHistograms> hist;
+
+    void enableHistograms() {
+        static_assert(HISTOGRAMS, "histograms need the plain counter stats policy");
+        if (!hist) hist.emplace();
+    }
+
+    // Bản sao bằng bộ đếm thường để in/so sánh/gộp
+    BasicHashStats<long long> snapshot() const {
+        BasicHashStats<long long> s;
+        s.totalProbesInsert = totalProbesInsert;
+        s.totalProbesSearch = totalProbesSearch;
+        s.totalProbesDelete = totalProbesDelete;
+        s.totalCollision = totalCollision;
+        s.nInsert = nInsert;
+        s.nSearch = nSearch;
+        s.nDelete = nDelete;
+        s.nCompact = nCompact;
+        s.nResize = nResize;
+        s.hist = hist;
+        return s;
+    }
+
+    // Đặt ở đầu một thao tác: khi ra khỏi scope ghi thời gian và số probe
+    // (độ chênh của probeCounter) vào histogram, không làm gì nếu histogram tắt
+    class OpScope {
+        OpHistograms* h = nullptr;
+        HistOp op;
+        const Counter& probeCounter;
+        long long probesBefore = 0;
+        bool outer = false;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        OpScope(BasicHashStats& stats, HistOp op, const Counter& probeCounter)
+            : op(op), probeCounter(probeCounter) {
+            if constexpr (HISTOGRAMS) {
+                if (!stats.hist) return;
+                h = &*stats.hist;
+                outer = h->depth++ == 0;
+                probesBefore = probeCounter;
+                start = std::chrono::steady_clock::now();
+            }
+            else {
+                (void)stats;
+            }
+        }
+
+        OpScope(const OpScope&) = delete;
+        OpScope& operator=(const OpScope&) = delete;
+
+        ~OpScope() {
+            if constexpr (HISTOGRAMS) {
+                if (!h) return;
+                h->depth--;
+                if (!outer && op != HIST_REHASH) return;
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                h->latency[op].record(static_cast<uint64_t>(ns));
+                h->probes[op].record(static_cast<uint64_t>(probeCounter - probesBefore));
+            }
+        }
+
+        // Search mặc định tính là miss, gọi khi tìm thấy key
+        void markHit() {
+            op = HIST_SEARCH_HIT;
+        }
+    };
 };
 
+using HashStats = BasicHashStats<long long>;
+using NoStats = BasicHashStats<StatsPolicy::NullCounter>;
+using ShardedStats = BasicHashStats<StatsPolicy::ShardedCounter>;
+
 namespace ClusterUtils {
+    template<typename K, typename V>
+    inline bool isOccupied(const Entry<K, V>& entry) {
+        return entry.state == OCCUPIED;
+    }
+
+    template<typename K, typename V>
+    inline bool isOccupied(const RobinHoodEntry<K, V>& entry) {
+        return entry.state == OCCUPIED;
+    }
+
+    template<typename K, typename V>
+    inline bool isOccupied(const HopscotchEntry<K, V>& entry) {
+        return entry.state == OCCUPIED;
+    }
+
+    // Với bảng theo bucket, cluster là dãy bucket đầy liên tiếp
+    template<typename K, typename V>
+    inline bool isOccupied(const CacheLineBucket<K, V>& bucket) {
+        return bucket.full();
+    }
+
+    // Mảng state của layout SoA
+    inline bool isOccupied(uint8_t state) {
+        return state == OCCUPIED;
+    }
+
+    // Mảng byte điều khiển của GroupDoubleHashTable (slot có key khi bit cao = 0)
+    inline bool isOccupied(int8_t ctrl) {
+        return ctrl >= 0;
+    }
+
     template<typename EntryType>
     static int maxClusterLength(const std::vector<EntryType>& table) {
         int maxLen = 0, curLen = 0;
         for (const auto& entry : table) {
-            if (entry.state == OCCUPIED) {
+            if (isOccupied(entry)) {
                 ++curLen;
                 maxLen = std::max(maxLen, curLen);
             } else {
@@ -60,7 +632,7 @@ namespace ClusterUtils {
     static double avgClusterLength(const std::vector<EntryType>& table) {
         int totalClusters = 0, totalLen = 0, curLen = 0;
         for (const auto& entry : table) {
-            if (entry.state == OCCUPIED) {
+            if (isOccupied(entry)) {
                 ++curLen;
             } else {
                 if (curLen > 0) {
@@ -97,10 +669,10 @@ namespace helper {
     }
 
     // Hàm kiểm tra số nguyên tố
-    bool isPrime(int n) {
+    constexpr bool isPrime(int n) {
         if (n < 2)
             return false;
-        for (int i = 2; i * i <= n; ++i) {
+        for (int i = 2; i <= n / i; ++i) {
             if (n % i == 0)
                 return false;
         }
@@ -113,6 +685,68 @@ namespace helper {
             ++x;
         return x;
     }
+    // Tìm số nguyên tố lớn nhất nhỏ hơn n (trả về 1 nếu không có)
+    int prevPrime(int n) {
+        int x = n - 1;
+        while (x > 1 && !isPrime(x))
+            --x;
+        return x > 1 ? x : 1;
+    }
+    // Phần cao 64 bit của tích 64x64 bit
+    constexpr uint64_t mulhi64(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+        if (!std::is_constant_evaluated())
+            return __umulh(a, b);
+#endif
+        uint64_t aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+        uint64_t bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+        uint64_t mid1 = aHi * bLo + ((aLo * bLo) >> 32);
+        uint64_t mid2 = aLo * bHi + (mid1 & 0xFFFFFFFFu);
+        return aHi * bHi + (mid1 >> 32) + (mid2 >> 32);
+#endif
+    }
+
+    // Chia lấy dư không dùng lệnh chia phần cứng (Lemire fastmod):
+    // M = ceil(2^64 / d) tính một lần, a % d = ((M * a) * d) >> 64 với a 32 bit
+    struct FastMod {
+        uint32_t d = 1;
+        uint64_t M = 0;
+
+        constexpr FastMod() = default;
+        constexpr explicit FastMod(uint32_t divisor) : d(divisor), M(UINT64_MAX / divisor + 1) {}
+
+        constexpr uint32_t mod(uint32_t a) const {
+            return static_cast<uint32_t>(mulhi64(M * a, d));
+        }
+    };
+
+    // Hash 64 bit được tách làm hai nửa độc lập: 32 bit thấp cho hash1, 32 bit cao cho hash2
+    inline uint32_t lo32(uint64_t h) {
+        return static_cast<uint32_t>(h);
+    }
+
+    inline uint32_t hi32(uint64_t h) {
+        return static_cast<uint32_t>(h >> 32);
+    }
+
+    // (a + b) % n khi a < n và b <= n: thay phép chia bằng phép trừ có điều kiện.
+    // Cộng trên uint32_t vì a + b có thể vượt INT_MAX với bậc lớn nhất của PrimeLadder
+    inline int addMod(int a, int b, int n) {
+        uint32_t s = static_cast<uint32_t>(a) + static_cast<uint32_t>(b);
+        return static_cast<int>(s >= static_cast<uint32_t>(n) ? s - n : s);
+    }
+
+    // Phân vị p (0-100) của một mẫu đã sắp xếp tăng dần
+    template<typename T>
+    T percentile(const std::vector<T>& sorted, double p) {
+        if (sorted.empty()) return T();
+        size_t idx = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(idx, sorted.size() - 1)];
+    }
+
     // Chuyển từ double sang string với precision tùy chỉnh
     std::string doubleToStr(double x, int precision = 2) {
         std::ostringstream oss;
@@ -121,251 +755,1750 @@ namespace helper {
     }
 }
 
-// ======= Double Hashing Table =======
-template<typename K, typename V>
-class DoubleHashTable {
-    int TABLE_SIZE;
-    int keysPresent;
-    int PRIME;
-    std::vector<Entry<K, V>> hashTable;
-    std::vector<bool> isPrimeArr;
-public:
-    HashStats stats;
-
-    DoubleHashTable(int n) {
-        TABLE_SIZE = n;
-        keysPresent = 0;
-        hashTable.assign(TABLE_SIZE, Entry<K, V>());
-
-        // Khởi tạo mảng kiểm tra số nguyên tố
-        isPrimeArr = std::vector<bool>(TABLE_SIZE, true);
-        if (TABLE_SIZE >= 2) isPrimeArr[0] = isPrimeArr[1] = false;
-        for (int i = 2; i * i < TABLE_SIZE; ++i) {
-            if (isPrimeArr[i]) {
-                for (int j = i * i; j < TABLE_SIZE; j += i) {
-                    isPrimeArr[j] = false;
-                }
-            }
-        }
+// ======= Hash policies =======
+// Mỗi key chỉ được băm một lần thành 64 bit; bảng lấy hash1 từ 32 bit thấp và
+// hash2 từ 32 bit cao, nên hasher phải trộn đều cả hai nửa.
+namespace HashUtils {
+    constexpr uint64_t P0 = 0xa0761d6478bd642full;
+    constexpr uint64_t P1 = 0xe7037ed1a0b428dbull;
+    constexpr uint64_t P2 = 0x8ebc6af09c88c6e3ull;
+    constexpr uint64_t P3 = 0x589965cc75374cc3ull;
+
+    constexpr uint64_t rotl(uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
 
-        // Tìm số nguyên tố lớn nhất < TABLE_SIZE
-        PRIME = TABLE_SIZE - 1;
-        while (PRIME > 1 && !isPrimeArr[PRIME])
-            PRIME--;
+    // Nhân 64x64 -> 128 bit rồi XOR hai nửa (wyhash)
+    constexpr uint64_t mum(uint64_t a, uint64_t b) {
+        return (a * b) ^ helper::mulhi64(a, b);
     }
-    
-    int hash1(const K& key) { 
-        return std::hash<K>{}(key) % TABLE_SIZE; 
+
+    // Finalizer rrmxmx của xxh3 cho số nguyên (tuyết lở trên cả 64 bit)
+    constexpr uint64_t mixInt(uint64_t x) {
+        x ^= rotl(x, 49) ^ rotl(x, 24);
+        x *= 0x9FB21C651E98DF25ull;
+        x ^= (x >> 35) + 8;
+        x *= 0x9FB21C651E98DF25ull;
+        return x ^ (x >> 28);
     }
 
-    int hash2(const K& key) { 
-        return PRIME - (std::hash<K>{}(key) % PRIME); 
+    inline uint64_t read64(const unsigned char* p) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
     }
 
-    bool isFull() {
-        return keysPresent == TABLE_SIZE;
+    // Băm chuỗi byte kiểu wyhash: mỗi 8 byte trộn một lần bằng mum
+    inline uint64_t hashBytes(const void* data, size_t len, uint64_t seed = P0) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        uint64_t h = seed ^ mum(len ^ P1, P2);
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8)
+            h = mum(read64(p + i) ^ P1, h ^ P2);
+        uint64_t tail = 0;
+        for (size_t j = 0; i + j < len; ++j)
+            tail |= static_cast<uint64_t>(p[i + j]) << (8 * j);
+        h = mum(tail ^ P3, h ^ len);
+        return mum(h ^ P0, P1 ^ h);
     }
 
-    bool insert(const K& key, const V& value) {
-        if (isFull()) return false;
-        int probe = hash1(key);
-        int offset = hash2(key);
-        int probes = 1;
-        if (hashTable[probe].state == OCCUPIED) 
-            stats.totalCollision++;
-        while (hashTable[probe].state == OCCUPIED && hashTable[probe].key != key) {
-            probe = (probe + offset) % TABLE_SIZE;
-            probes++;
+    // Hasher mặc định: trộn mạnh cho số nguyên và chuỗi,
+    // các kiểu khác dùng std::hash rồi trộn lại
+    template<typename K>
+    struct MixHash {
+        uint64_t operator()(const K& key) const {
+            if constexpr (std::is_integral_v<K> || std::is_enum_v<K>) {
+                return mixInt(static_cast<uint64_t>(key) ^ P0);
+            }
+            else if constexpr (std::is_convertible_v<const K&, std::string_view>) {
+                std::string_view sv(key);
+                return hashBytes(sv.data(), sv.size());
+            }
+            else {
+                return mixInt(static_cast<uint64_t>(std::hash<K>{}(key)) ^ P0);
+            }
         }
-        if (hashTable[probe].state != OCCUPIED) {
-            hashTable[probe].key = key;
-            hashTable[probe].value = value;
-            hashTable[probe].state = OCCUPIED;
-            keysPresent++;
-            stats.totalProbesInsert += probes;
-            stats.nInsert++;
-            return true;
+    };
+
+    // std::hash (identity với số nguyên trong libstdc++), nhân bản 32 bit thấp lên nửa cao
+    // để hash1 = h % TABLE_SIZE, hash2 = PRIME - h % PRIME như trước; dùng làm mốc so sánh
+    template<typename K>
+    struct StdHash {
+        uint64_t operator()(const K& key) const {
+            uint64_t h = static_cast<uint32_t>(std::hash<K>{}(key));
+            return h | (h << 32);
         }
-        else if (hashTable[probe].key == key) { 
-            hashTable[probe].value = value;
-            return true;
+    };
+}
+
+// ======= Prime size ladder =======
+// Bảng kích thước nguyên tố tính sẵn lúc biên dịch: từ 41 trở đi mỗi bậc là nextPrime(2 * p)
+// của bậc trước, các bậc nhỏ 3, 7, 11, 19 dày hơn cho bảng nhỏ; kèm PRIME cho hash2
+// và hằng số FastMod của cả hai.
+// Khởi tạo và rehash chỉ cần tra bảng, không phải sàng hay chia thử.
+namespace PrimeLadder {
+    struct Rung {
+        int size;   // TABLE_SIZE
+        int prime;  // số nguyên tố lớn nhất < size
+        helper::FastMod modSize;
+        helper::FastMod modPrime;
+    };
+
+    constexpr Rung make(int size, int prime) {
+        return { size, prime, helper::FastMod(size), helper::FastMod(prime) };
+    }
+
+    inline constexpr Rung RUNGS[] = {
+        make(3, 2),
+        make(7, 5),
+        make(11, 7),
+        make(19, 17),
+        make(41, 37),
+        make(83, 79),
+        make(167, 163),
+        make(337, 331),
+        make(677, 673),
+        make(1361, 1327),
+        make(2729, 2719),
+        make(5471, 5449),
+        make(10949, 10939),
+        make(21911, 21893),
+        make(43853, 43801),
+        make(87719, 87701),
+        make(175447, 175433),
+        make(350899, 350891),
+        make(701819, 701791),
+        make(1403641, 1403627),
+        make(2807303, 2807239),
+        make(5614657, 5614597),
+        make(11229331, 11229301),
+        make(22458671, 22458643),
+        make(44917381, 44917337),
+        make(89834777, 89834747),
+        make(179669557, 179669543),
+        make(359339171, 359339093),
+        make(718678369, 718678339),
+        make(1437356741, 1437356699),
+    };
+    inline constexpr int NUM_RUNGS = sizeof(RUNGS) / sizeof(RUNGS[0]);
+
+    constexpr bool verify() {
+        for (int i = 0; i < NUM_RUNGS; ++i) {
+            if (!helper::isPrime(RUNGS[i].size) || !helper::isPrime(RUNGS[i].prime) || RUNGS[i].prime >= RUNGS[i].size)
+                return false;
+            if (i > 0 && RUNGS[i].size <= RUNGS[i - 1].size)
+                return false;
         }
-        return false;
+        return true;
     }
+    static_assert(verify(), "PrimeLadder: bảng số nguyên tố không hợp lệ");
 
-    bool search(const K& key, V& outValue) {
-        int probe = hash1(key);
-        int offset = hash2(key);
-        int initialPos = probe;
-        int probes = 1;
-        bool firstItr = true;
-        while (true) {
-            if (hashTable[probe].state == EMPTY) 
-                break;
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                outValue = hashTable[probe].value;
-                stats.totalProbesSearch += probes; 
-                stats.nSearch++;
-                return true;
-            }
-            if (probe == initialPos && !firstItr) 
-                break;
-            probe = (probe + offset) % TABLE_SIZE;
-            probes++; 
-            firstItr = false;
+    // Bậc nhỏ nhất có size >= n (bậc cuối nếu n quá lớn)
+    constexpr const Rung& atLeast(long long n) {
+        for (int i = 0; i < NUM_RUNGS; ++i) {
+            if (RUNGS[i].size >= n)
+                return RUNGS[i];
         }
-        stats.totalProbesSearch += probes; 
-        stats.nSearch++;
-        return false;
+        return RUNGS[NUM_RUNGS - 1];
     }
 
-    void erase(const K& key) {
-        int probe = hash1(key);
-        int offset = hash2(key);
-        int initialPos = probe;
-        int probes = 1;
-        bool firstItr = true;
-        while (true) {
-            if (hashTable[probe].state == EMPTY) { 
-                stats.totalProbesDelete += probes; 
-                stats.nDelete++; 
-                return; 
-            }
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                hashTable[probe].state = DELETED; 
-                keysPresent--;
-                stats.totalProbesDelete += probes; 
-                stats.nDelete++; 
-                return;
-            }
-            if (probe == initialPos && !firstItr) { 
-                stats.totalProbesDelete += probes; 
-                stats.nDelete++; 
-                return; 
-            }
-            probe = (probe + offset) % TABLE_SIZE;
-            probes++; 
-            firstItr = false;
+    // Bậc lớn nhất có size <= n (bậc đầu nếu n quá nhỏ)
+    constexpr const Rung& atMost(long long n) {
+        for (int i = NUM_RUNGS - 1; i > 0; --i) {
+            if (RUNGS[i].size <= n)
+                return RUNGS[i];
         }
+        return RUNGS[0];
     }
 
-    int maxClusterLength() const {
-        return ClusterUtils::maxClusterLength(hashTable);
+    // Số nguyên tố lớn nhất < n trong bảng (size hoặc prime của một bậc), 1 nếu không có
+    constexpr int primeBelow(int n) {
+        int best = 1;
+        for (int i = 0; i < NUM_RUNGS; ++i) {
+            if (RUNGS[i].prime < n) best = std::max(best, RUNGS[i].prime);
+            if (RUNGS[i].size < n) best = std::max(best, RUNGS[i].size);
+        }
+        return best;
     }
 
-    double avgClusterLength() const {
-        return ClusterUtils::avgClusterLength(hashTable);
+    // Bậc có size == n, nullptr nếu n không nằm trong bảng
+    constexpr const Rung* find(int n) {
+        for (int i = 0; i < NUM_RUNGS; ++i) {
+            if (RUNGS[i].size == n)
+                return &RUNGS[i];
+        }
+        return nullptr;
     }
-};
+}
 
-// ======= Linear Probing Table =======
-template<typename K, typename V>
-class LinearHashTable {
-    int TABLE_SIZE;
-    int keysPresent;
-    std::vector<Entry<K, V>> hashTable;
-public:
-    HashStats stats;
+// ======= Sizing policies cho double hashing =======
+// Quyết định TABLE_SIZE, cách rút gọn hash về chỉ số (hash1), bước nhảy (hash2)
+// và phép cộng vòng của probe.
+
+// TABLE_SIZE nguyên tố, hash2 = PRIME - h % PRIME với PRIME nguyên tố < TABLE_SIZE
+struct PrimeSizing {
+    static constexpr int MAX_TABLE_SIZE = PrimeLadder::RUNGS[PrimeLadder::NUM_RUNGS - 1].size;
+
+    int TABLE_SIZE = 0;
+    int PRIME = 1;
+    bool primeSize = true;  // TABLE_SIZE nguyên tố: mọi bước nhảy trong [1, PRIME] đi qua mọi slot
+    helper::FastMod modSize, modPrime;
+
+    void apply(const PrimeLadder::Rung& rung) {
+        TABLE_SIZE = rung.size;
+        PRIME = rung.prime;
+        primeSize = true;
+        modSize = rung.modSize;
+        modPrime = rung.modPrime;
+    }
 
-    LinearHashTable(int n) {
+    // Bảng tĩnh: đúng n slot, tra PrimeLadder nếu n là một bậc.
+    // n không phải bậc vẫn giữ nguyên (benchmark chọn n để đạt đúng load factor), còn PRIME
+    // lấy số nguyên tố gần nhất dưới n có sẵn trong PrimeLadder thay vì tìm lại.
+    // Chỉ khi n nguyên tố thì bước nhảy nguyên tố cùng nhau với n và dãy probe đi qua mọi
+    // slot; n hợp số (60, 1365, ...) thì bước nhảy có thể chung ước với n, dãy probe chỉ
+    // phủ một phần bảng và fullCycle() trả về false (kiểm tra nguyên tố một lần, không tìm kiếm)
+    void init(int n) {
+        if (const PrimeLadder::Rung* rung = PrimeLadder::find(n)) {
+            apply(*rung);
+            return;
+        }
         TABLE_SIZE = n;
-        keysPresent = 0;
-        hashTable.assign(TABLE_SIZE, Entry<K, V>());
+        PRIME = PrimeLadder::primeBelow(n);
+        primeSize = helper::isPrime(n);
+        modSize = helper::FastMod(TABLE_SIZE);
+        modPrime = helper::FastMod(PRIME);
     }
 
-    int hash(const K& key) {
-        return std::hash<K>{}(key) % TABLE_SIZE;
+    // Bảng động: bậc nhỏ nhất của PrimeLadder >= n.
+    // Trả về false nếu không có bậc nào đủ lớn (khi đó dùng bậc cuối)
+    bool grow(long long n) {
+        apply(PrimeLadder::atLeast(n));
+        return n <= MAX_TABLE_SIZE;
     }
 
-    bool isFull() {
-        return keysPresent == TABLE_SIZE;
+    int home(uint64_t h) const {
+        return modSize.mod(helper::lo32(h));
     }
 
-    bool insert(const K& key, const V& value) {
-        if (isFull()) return false;
-        int probe = hash(key);
-        int probes = 1;
-        if (hashTable[probe].state == OCCUPIED)
-            stats.totalCollision++;
-        while (hashTable[probe].state == OCCUPIED && hashTable[probe].key != key) {
-            probe = (probe + 1) % TABLE_SIZE;
-            probes++;
-        }
-        if (hashTable[probe].state != OCCUPIED) {
-            hashTable[probe] = Entry<K, V>(key, value, OCCUPIED);
-            keysPresent++;
-            stats.totalProbesInsert += probes;
-            stats.nInsert++;
-            return true;
-        } else if (hashTable[probe].key == key) {
-            hashTable[probe].value = value;
-            return true;
-        }
-        return false;
+    int stride(uint64_t h) const {
+        return PRIME - modPrime.mod(helper::hi32(h));
     }
 
-    bool search(const K& key, V& outValue) {
-        int probe = hash(key);
-        int probes = 1;
-        while (hashTable[probe].state != EMPTY) {
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                outValue = hashTable[probe].value;
-                stats.totalProbesSearch += probes;
-                stats.nSearch++;
-                return true;
-            }
-            probe = (probe + 1) % TABLE_SIZE;
-            probes++;
-        }
-        stats.totalProbesSearch += probes;
-        stats.nSearch++;
-        return false;
+    // Dãy home + i * stride có đi qua mọi slot với mọi hash không
+    bool fullCycle() const {
+        return primeSize;
     }
 
-    void erase(const K& key) {
-        int probe = hash(key);
-        int probes = 1;
-        while (hashTable[probe].state != EMPTY) {
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                hashTable[probe].state = DELETED;
-                keysPresent--;
-                stats.totalProbesDelete += probes;
-                stats.nDelete++;
-                return;
-            }
-            probe = (probe + 1) % TABLE_SIZE;
-            probes++;
-        }
-        stats.totalProbesDelete += probes;
-        stats.nDelete++;
+    int next(int probe, int offset) const {
+        return helper::addMod(probe, offset, TABLE_SIZE);
     }
+};
 
-    int maxClusterLength() const {
-        return ClusterUtils::maxClusterLength(hashTable);
-    }
+// TABLE_SIZE là lũy thừa của 2: rút gọn bằng mask, bước nhảy luôn lẻ
+// nên nguyên tố cùng nhau với TABLE_SIZE và vẫn đi qua mọi slot
+struct Pow2Sizing {
+    static constexpr int MAX_BITS = 30;
+    static constexpr int MAX_TABLE_SIZE = 1 << MAX_BITS;
+
+    int TABLE_SIZE = 0;
+    int BITS = 0;
+    uint32_t MASK = 0;
+
+    void setBits(int bits) {
+        BITS = bits;
+        TABLE_SIZE = 1 << bits;
+        MASK = static_cast<uint32_t>(TABLE_SIZE - 1);
+    }
+
+    // Bảng tĩnh: lũy thừa của 2 nhỏ nhất >= n (tối thiểu 2)
+    void init(int n) {
+        int bits = 1;
+        while (bits < MAX_BITS && (1 << bits) < n) ++bits;
+        setBits(bits);
+    }
+
+    // Bảng động: lũy thừa của 2 nhỏ nhất >= n.
+    // Trả về false nếu n vượt MAX_TABLE_SIZE (khi đó dùng MAX_TABLE_SIZE)
+    bool grow(long long n) {
+        int bits = 1;
+        while (bits < MAX_BITS && (1LL << bits) < n) ++bits;
+        setBits(bits);
+        return n <= MAX_TABLE_SIZE;
+    }
+
+    int home(uint64_t h) const {
+        return static_cast<int>(helper::lo32(h) & MASK);
+    }
+
+    // Bước nhảy lấy BITS bit cao của nửa cao, ép lẻ
+    int stride(uint64_t h) const {
+        return static_cast<int>(helper::hi32(h) >> (32 - BITS)) | 1;
+    }
+
+    // Bước nhảy lẻ luôn nguyên tố cùng nhau với lũy thừa của 2
+    bool fullCycle() const {
+        return true;
+    }
+
+    int next(int probe, int offset) const {
+        return static_cast<int>(static_cast<uint32_t>(probe + offset) & MASK);
+    }
+};
+
+// ======= Interleaved lookup (AMAC) =======
+// Mỗi "lane" là một coroutine dò bảng cho một chuỗi key; sau mỗi lần prefetch slot
+// kế tiếp lane nhường CPU cho lane khác, nên cache miss của nhiều chuỗi probe chồng lên nhau
+namespace Interleave {
+    // Số lane mặc định, đủ để phủ độ trễ DRAM mà không tràn bộ đệm line-fill
+    constexpr int DEFAULT_LANES = 16;
+
+    struct Task {
+        struct promise_type {
+            Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> handle;
+
+        explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+        Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task() {
+            if (handle) handle.destroy();
+        }
+
+        bool done() const { return handle.done(); }
+        void resume() { handle.resume(); }
+    };
+
+    // co_await PrefetchSlot{slots, i}: phát prefetch cho slot i rồi nhường lượt
+    template<typename Slots>
+    struct PrefetchSlot {
+        const Slots& slots;
+        int i;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>) const noexcept { slots.prefetch(i); }
+        void await_resume() const noexcept {}
+    };
+
+    // Chạy vòng tròn qua các lane cho tới khi tất cả kết thúc
+    inline void runRoundRobin(std::vector<Task>& lanes) {
+        bool active = true;
+        while (active) {
+            active = false;
+            for (auto& lane : lanes) {
+                if (lane.done()) continue;
+                lane.resume();
+                active = active || !lane.done();
+            }
+        }
+    }
+}
+
+// ======= Probe policies =======
+// Dãy probe của một key: khởi tạo từ hash (pos = slot gốc), next() chuyển sang slot kế tiếp.
+// Mỗi policy là một struct nhỏ nằm trong thanh ghi, nên vòng probe của từng tổ hợp được
+// compiler inline và chuyên biệt hóa hoàn toàn.
+// coversTable(sizing): TABLE_SIZE bước probe đầu tiên đi qua mọi slot với kích thước hiện tại,
+// nên luôn tìm được slot trống khi bảng chưa đầy (điều kiện để compactInPlace không kẹt)
+struct LinearProbe {
+    int pos;
+
+    template<typename Sizing>
+    static bool coversTable(const Sizing&) { return true; }
+
+    template<typename Sizing>
+    LinearProbe(const Sizing& sz, uint64_t h) : pos(sz.home(h)) {}
+
+    template<typename Sizing>
+    void next(const Sizing& sz) {
+        pos = helper::addMod(pos, 1, sz.TABLE_SIZE);
+    }
+};
+
+// Chỉ đi qua một phần các slot: với TABLE_SIZE nguyên tố chỉ chắc chắn (TABLE_SIZE + 1) / 2 slot
+// phân biệt, với kích thước khác có thể còn ít hơn nhiều
+struct QuadraticProbe {
+    int pos;
+    int step = 1;  // (i+1)^2 - i^2 = 2i + 1
+
+    template<typename Sizing>
+    static bool coversTable(const Sizing&) { return false; }
+
+    template<typename Sizing>
+    QuadraticProbe(const Sizing& sz, uint64_t h) : pos(sz.home(h)) {}
+
+    template<typename Sizing>
+    void next(const Sizing& sz) {
+        pos = helper::addMod(pos, step, sz.TABLE_SIZE);
+        step = helper::addMod(step, 2, sz.TABLE_SIZE);
+    }
+};
+
+// hash1 = slot gốc, hash2 = bước nhảy, cả hai do Sizing tính từ hai nửa của hash
+// Chỉ phủ hết bảng khi mọi bước nhảy nguyên tố cùng nhau với TABLE_SIZE (Sizing::fullCycle)
+struct DoubleProbe {
+    int pos;
+    int offset;
+
+    template<typename Sizing>
+    static bool coversTable(const Sizing& sz) { return sz.fullCycle(); }
+
+    template<typename Sizing>
+    DoubleProbe(const Sizing& sz, uint64_t h) : pos(sz.home(h)), offset(sz.stride(h)) {}
+
+    template<typename Sizing>
+    void next(const Sizing& sz) {
+        pos = sz.next(pos, offset);
+    }
+};
+
+// ======= Growth policies =======
+// Bảng tĩnh: đúng kích thước yêu cầu, insert thất bại khi đầy
+struct FixedCapacity {
+    static constexpr bool DYNAMIC = false;
+
+    template<typename Sizing>
+    static void init(Sizing& sz, int n) { sz.init(n); }
+};
+
+// Bảng động: bắt đầu từ kích thước hợp lệ >= n, nhân đôi khi vượt MAX_LOAD_FACTOR.
+// Ở Sizing::MAX_TABLE_SIZE bảng ngừng lớn thêm và insert thất bại khi hết slot
+struct LoadFactorGrowth {
+    static constexpr bool DYNAMIC = true;
+    static constexpr double MAX_LOAD_FACTOR = 0.7;
+
+    template<typename Sizing>
+    static void init(Sizing& sz, int n) { sz.grow(n); }
+};
+
+// ======= Open Addressing Table =======
+// Lõi chung cho mọi bảng địa chỉ mở một slot mỗi vị trí:
+// Probe: LinearProbe, QuadraticProbe hoặc DoubleProbe
+// Growth: FixedCapacity hoặc LoadFactorGrowth
+// Stats: HashStats, NoStats hoặc ShardedStats
+// Slots: layout lưu trữ slot (AoSSlots hoặc SoASlots)
+// Sizing: PrimeSizing (TABLE_SIZE = n) hoặc Pow2Sizing (làm tròn lên lũy thừa của 2)
+// Hasher: hàm băm 64 bit (HashUtils::MixHash hoặc HashUtils::StdHash)
+template<typename K, typename V, typename Probe, typename Growth = FixedCapacity, typename Stats = HashStats,
+    template<typename, typename> class Slots = AoSSlots, typename Sizing = PrimeSizing, typename Hasher = HashUtils::MixHash<K>>
+class OpenAddressTable {
+    // Migration và compact của bảng động đặt lại entry ở load < 0.5; probe không phủ hết bảng
+    // chỉ chắc chắn tìm được slot trống trong nửa bảng đó khi TABLE_SIZE nguyên tố
+    // (bảng động luôn lấy kích thước từ Sizing::grow, nên double/linear probe luôn phủ hết bảng)
+    static_assert(!std::is_same_v<Probe, QuadraticProbe> || !Growth::DYNAMIC || std::is_same_v<Sizing, PrimeSizing>,
+        "bảng động với quadratic probe cần PrimeSizing");
+
+    int TABLE_SIZE;
+    int keysPresent;
+    int tombstones;  // chỉ tính trên bảng mới, tombstone ở bảng cũ biến mất khi migration xong
+    int compactAt = 0;  // sau một lần rebuild thất bại, chỉ thử lại khi tombstone vượt mốc này
+    Hasher hasher;
+    Sizing sizing;
+    Slots<K, V> hashTable;
+
+    // Rehash tăng dần (chỉ bảng động): bảng cũ tồn tại song song với bảng mới, mỗi thao tác
+    // chuyển MIGRATE_STEP slot cũ sang; oldSize == 0 khi không có migration
+    static constexpr int MIGRATE_STEP = 16;
+    bool incremental;
+    Slots<K, V> oldTable;
+    Sizing oldSizing;
+    int oldSize = 0;
+    int migratePos = 0;
+
+    // Tìm key trong một mảng slot với sizing tương ứng, trả về vị trí hoặc -1
+    int findSlot(const Slots<K, V>& table, const Sizing& sz, uint64_t h, const K& key, int& probes) const {
+        Probe p(sz, h);
+        for (int i = 0; i < sz.TABLE_SIZE; ++i) {
+            probes++;
+            SlotState st = table.state(p.pos);
+            if (st == EMPTY)
+                return -1;
+            if (st == OCCUPIED && table.key(p.pos) == key)
+                return p.pos;
+            p.next(sz);
+        }
+        return -1;
+    }
+
+    // Slot đầu tiên không OCCUPIED trong TABLE_SIZE bước probe của key, -1 nếu không có
+    int firstFree(const K& key) const {
+        Probe p(sizing, hasher(key));
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            if (hashTable.state(p.pos) != OCCUPIED)
+                return p.pos;
+            p.next(sizing);
+        }
+        return -1;
+    }
+
+    // Đặt một entry đã biết chắc chưa có trong bảng mới (dùng khi migration).
+    // Bảng mới có load < 0.5 nên firstFree luôn thành công (xem static_assert ở đầu lớp)
+    void place(const K& key, const V& value) {
+        int pos = firstFree(key);
+        if (hashTable.state(pos) == DELETED)
+            tombstones--;
+        hashTable.set(pos, key, value);
+    }
+
+    void migrateStep(int budget) {
+        int end = std::min(oldSize, migratePos + budget);
+        for (; migratePos < end; ++migratePos) {
+            if (oldTable.state(migratePos) == OCCUPIED) {
+                place(oldTable.key(migratePos), oldTable.value(migratePos));
+                // Bản cũ thành tombstone: search/erase không thấy lại, chuỗi probe của bảng cũ vẫn giữ
+                oldTable.markDeleted(migratePos);
+            }
+        }
+        if (migratePos == oldSize) {
+            oldTable = Slots<K, V>();
+            oldSize = 0;
+        }
+    }
+
+    void startMigration(long long new_size_hint) {
+        typename Stats::OpScope scope(stats, HIST_REHASH, stats.totalProbesInsert);
+        finishRehash();
+        oldTable = std::move(hashTable);
+        oldSizing = sizing;
+        oldSize = TABLE_SIZE;
+        migratePos = 0;
+
+        sizing.grow(new_size_hint);
+        TABLE_SIZE = sizing.TABLE_SIZE;
+        tombstones = 0;
+        compactAt = 0;
+        hashTable.assign(TABLE_SIZE);
+        stats.nResize++;
+    }
+
+    // Dọn tombstone ngoài chỗ, giữ nguyên kích thước (cho probe không phủ hết bảng).
+    // Nếu có entry không tìm được slot trên dãy probe của nó thì trả lại bảng cũ và báo false.
+    // pendingLive: bảng cũ là kết quả compactInPlace dừng giữa chừng, DELETED cũng là entry sống
+    bool rebuild(bool pendingLive = false) {
+        Slots<K, V> prevTable = std::move(hashTable);
+        hashTable.assign(TABLE_SIZE);
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            SlotState st = prevTable.state(i);
+            if (st != OCCUPIED && !(pendingLive && st == DELETED))
+                continue;
+            int pos = firstFree(prevTable.key(i));
+            if (pos < 0) {
+                hashTable = std::move(prevTable);
+                return false;
+            }
+            hashTable.set(pos, prevTable.key(i), prevTable.value(i));
+        }
+        return true;
+    }
+
+    // Phần thân insert/search sau khi đã có hash (dùng chung cho API đơn lẻ và batch)
+    bool insertHashed(const K& key, uint64_t h, const V& value) {
+        if constexpr (Growth::DYNAMIC) {
+            if (isMigrating())
+                migrateStep(MIGRATE_STEP);
+            if (usedLoadFactor() > Growth::MAX_LOAD_FACTOR) {
+                // Bảng đầy chủ yếu vì tombstone: dọn tại chỗ thay vì nhân đôi
+                if (loadFactor() <= Growth::MAX_LOAD_FACTOR / 2)
+                    compact();
+                // Đã ở kích thước lớn nhất: dùng nốt slot còn lại thay vì rehash cùng cỡ mỗi lần insert
+                else if (TABLE_SIZE < Sizing::MAX_TABLE_SIZE) {
+                    if (incremental)
+                        startMigration(2LL * TABLE_SIZE);
+                    else
+                        rehash(2LL * TABLE_SIZE);
+                }
+            }
+
+            // Key còn ở bảng cũ thì gỡ ra, bản mới sẽ nằm ở bảng mới
+            if (isMigrating()) {
+                int oldProbes = 0;
+                int pos = findSlot(oldTable, oldSizing, h, key, oldProbes);
+                if (pos >= 0) {
+                    oldTable.markDeleted(pos);
+                    keysPresent--;
+                }
+            }
+        }
+        else {
+            if (isFull()) return false;
+        }
+
+        Probe p(sizing, h);
+        int probes = 0;
+        int target = -1;
+        if (hashTable.state(p.pos) == OCCUPIED)
+            stats.totalCollision++;
+        // Đi tới slot EMPTY để chắc key chưa có, nhớ tombstone đầu tiên để tái sử dụng
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            probes++;
+            SlotState st = hashTable.state(p.pos);
+            if (st == EMPTY) {
+                if (target < 0) target = p.pos;
+                break;
+            }
+            if (st == OCCUPIED) {
+                if (hashTable.key(p.pos) == key) {
+                    hashTable.setValue(p.pos, value);
+                    return true;
+                }
+            }
+            else if (target < 0) {
+                target = p.pos;
+            }
+            p.next(sizing);
+        }
+        if (target < 0) return false;
+
+        if (hashTable.state(target) == DELETED)
+            tombstones--;
+        hashTable.set(target, key, value);
+        keysPresent++;
+        stats.totalProbesInsert += probes;
+        stats.nInsert++;
+        return true;
+    }
+
+    bool searchHashed(const K& key, uint64_t h, V& outValue) {
+        int probes = 0;
+        const Slots<K, V>* table = &hashTable;
+        int pos;
+        if constexpr (Growth::DYNAMIC) {
+            if (isMigrating())
+                migrateStep(MIGRATE_STEP);
+            pos = findSlot(hashTable, sizing, h, key, probes);
+            if (pos < 0 && isMigrating()) {
+                pos = findSlot(oldTable, oldSizing, h, key, probes);
+                table = &oldTable;
+            }
+        }
+        else {
+            pos = findSlot(hashTable, sizing, h, key, probes);
+        }
+        stats.totalProbesSearch += probes;
+        stats.nSearch++;
+        if (pos < 0)
+            return false;
+        outValue = table->value(pos);
+        return true;
+    }
+
+    // Hash cả cửa sổ key, prefetch slot gốc và slot của bước probe kế tiếp trong bảng mới
+    void prefetchWindow(const K* keys, int cnt, uint64_t* hs) const {
+        for (int j = 0; j < cnt; ++j) {
+            hs[j] = hasher(keys[j]);
+            Probe p(sizing, hs[j]);
+            hashTable.prefetch(p.pos);
+            p.next(sizing);
+            hashTable.prefetch(p.pos);
+        }
+    }
+
+    // Một lane lấy lần lượt key chưa xử lý (next) và dò bảng, suspend sau mỗi prefetch
+    Interleave::Task lookupLane(const std::vector<K>& keys, std::vector<V>& outValues, std::vector<bool>& found, int& next) {
+        int n = static_cast<int>(keys.size());
+        for (int idx = next++; idx < n; idx = next++) {
+            Probe p(sizing, hasher(keys[idx]));
+            int probes = 0;
+            co_await Interleave::PrefetchSlot<Slots<K, V>>{ hashTable, p.pos };
+            for (int i = 0; i < TABLE_SIZE; ++i) {
+                probes++;
+                SlotState st = hashTable.state(p.pos);
+                if (st == EMPTY)
+                    break;
+                if (st == OCCUPIED && hashTable.key(p.pos) == keys[idx]) {
+                    outValues[idx] = hashTable.value(p.pos);
+                    found[idx] = true;
+                    break;
+                }
+                p.next(sizing);
+                co_await Interleave::PrefetchSlot<Slots<K, V>>{ hashTable, p.pos };
+            }
+            stats.totalProbesSearch += probes;
+            stats.nSearch++;
+        }
+    }
+
+public:
+    // Số key được hash + prefetch trước khi bắt đầu dò bảng trong các API batch
+    static constexpr int BATCH_WINDOW = 16;
+
+    Stats stats;
+
+    // Bảng tĩnh: n slot (Sizing có thể làm tròn); bảng động: kích thước ban đầu.
+    // incrementalRehash = true (chỉ bảng động): khi vượt MAX_LOAD_FACTOR không rehash toàn bộ
+    // một lần mà chia việc di chuyển entry cho các thao tác insert/search/erase tiếp theo
+    OpenAddressTable(int n = 101, bool incrementalRehash = false) {
+        Growth::init(sizing, n);
+        TABLE_SIZE = sizing.TABLE_SIZE;
+        keysPresent = 0;
+        tombstones = 0;
+        incremental = Growth::DYNAMIC && incrementalRehash;
+        hashTable.assign(TABLE_SIZE);
+    }
+
+    int hash(const K& key) const {
+        return sizing.home(hasher(key));
+    }
+
+    int hash1(const K& key) const {
+        return sizing.home(hasher(key));
+    }
+
+    int hash2(const K& key) const requires std::is_same_v<Probe, DoubleProbe> {
+        return sizing.stride(hasher(key));
+    }
+
+    bool isFull() {
+        return keysPresent == TABLE_SIZE;
+    }
+
+    bool insert(const K& key, const V& value) {
+        typename Stats::OpScope scope(stats, HIST_INSERT, stats.totalProbesInsert);
+        return insertHashed(key, hasher(key), value);
+    }
+
+    bool search(const K& key, V& outValue) {
+        typename Stats::OpScope scope(stats, HIST_SEARCH_MISS, stats.totalProbesSearch);
+        if (!searchHashed(key, hasher(key), outValue))
+            return false;
+        scope.markHit();
+        return true;
+    }
+
+    // Tra cứu nhiều key: cache miss của cả cửa sổ được phát đi cùng lúc thay vì nối tiếp nhau
+    void search_batch(const std::vector<K>& keys, std::vector<V>& outValues, std::vector<bool>& found) {
+        int n = static_cast<int>(keys.size());
+        outValues.resize(n);
+        found.assign(n, false);
+        uint64_t hs[BATCH_WINDOW];
+        for (int base = 0; base < n; base += BATCH_WINDOW) {
+            int cnt = std::min(BATCH_WINDOW, n - base);
+            prefetchWindow(&keys[base], cnt, hs);
+            for (int j = 0; j < cnt; ++j)
+                found[base + j] = searchHashed(keys[base + j], hs[j], outValues[base + j]);
+        }
+    }
+
+    // Như search_batch nhưng mỗi chuỗi probe là một coroutine, mọi bước nhảy (không chỉ
+    // slot đầu) đều được prefetch và xen kẽ với các lane khác. Lane chỉ dò bảng mới nên
+    // migration đang dở được chuyển nốt trước
+    void search_interleaved(const std::vector<K>& keys, std::vector<V>& outValues, std::vector<bool>& found, int lanes = Interleave::DEFAULT_LANES) {
+        finishRehash();
+        int n = static_cast<int>(keys.size());
+        outValues.resize(n);
+        found.assign(n, false);
+        int next = 0;
+        std::vector<Interleave::Task> tasks;
+        tasks.reserve(std::max(1, lanes));
+        for (int l = 0; l < std::max(1, lanes); ++l)
+            tasks.push_back(lookupLane(keys, outValues, found, next));
+        Interleave::runRoundRobin(tasks);
+    }
+
+    // Chèn nhiều cặp key/value, trả về số cặp chèn hoặc cập nhật thành công.
+    // Rehash giữa cửa sổ chỉ làm prefetch vô ích, vị trí luôn tính lại từ hash
+    int insert_batch(const std::vector<K>& keys, const std::vector<V>& values) {
+        int n = static_cast<int>(std::min(keys.size(), values.size()));
+        int ok = 0;
+        uint64_t hs[BATCH_WINDOW];
+        for (int base = 0; base < n; base += BATCH_WINDOW) {
+            int cnt = std::min(BATCH_WINDOW, n - base);
+            prefetchWindow(&keys[base], cnt, hs);
+            for (int j = 0; j < cnt; ++j)
+                ok += insertHashed(keys[base + j], hs[j], values[base + j]);
+        }
+        return ok;
+    }
+
+    void erase(const K& key) {
+        typename Stats::OpScope scope(stats, HIST_ERASE, stats.totalProbesDelete);
+        uint64_t h = hasher(key);
+        int probes = 0;
+        Slots<K, V>* table = &hashTable;
+        int pos;
+        if constexpr (Growth::DYNAMIC) {
+            if (isMigrating())
+                migrateStep(MIGRATE_STEP);
+            pos = findSlot(hashTable, sizing, h, key, probes);
+            if (pos < 0 && isMigrating()) {
+                pos = findSlot(oldTable, oldSizing, h, key, probes);
+                table = &oldTable;
+            }
+        }
+        else {
+            pos = findSlot(hashTable, sizing, h, key, probes);
+        }
+        if (pos >= 0) {
+            table->markDeleted(pos);
+            keysPresent--;
+            if (table == &hashTable)
+                tombstones++;
+        }
+        stats.totalProbesDelete += probes;
+        stats.nDelete++;
+        if (tombstones > TombstoneUtils::MAX_TOMBSTONE_RATIO * TABLE_SIZE && tombstones >= compactAt)
+            compact();
+    }
+
+    // Dọn toàn bộ tombstone, giữ nguyên kích thước; đang migration thì chuyển nốt trước.
+    // Dãy probe phủ hết bảng với kích thước hiện tại: dọn tại chỗ. Còn lại (quadratic, double
+    // hashing trên kích thước hợp số): dựng lại ngoài chỗ, nếu không đặt lại được mọi entry
+    // thì giữ nguyên tombstone và trả về false
+    bool compact() {
+        typename Stats::OpScope scope(stats, HIST_REHASH, stats.totalProbesInsert);
+        finishRehash();
+        if (Probe::coversTable(sizing)) {
+            // Phòng khi firstFree vẫn không tìm thấy slot: dựng lại ngoài chỗ từ entry còn sống.
+            // Với dãy probe phủ hết bảng, mảng mới luôn còn chỗ nên rebuild này không thất bại
+            if (!TombstoneUtils::compactInPlace(hashTable, TABLE_SIZE, [this](const K& key) { return firstFree(key); }))
+                rebuild(true);
+        }
+        else if (!rebuild()) {
+            compactAt = tombstones + std::max(1, TABLE_SIZE / 16);
+            return false;
+        }
+        tombstones = 0;
+        compactAt = 0;
+        stats.nCompact++;
+        return true;
+    }
+
+    // Kích thước mới do Sizing chọn: kích thước hợp lệ nhỏ nhất >= new_size_hint
+    void rehash(long long new_size_hint) {
+        typename Stats::OpScope scope(stats, HIST_REHASH, stats.totalProbesInsert);
+        finishRehash();
+        int prevSize = TABLE_SIZE;
+        Slots<K, V> prevTable = std::move(hashTable);
+
+        sizing.grow(new_size_hint);
+        TABLE_SIZE = sizing.TABLE_SIZE;
+        keysPresent = 0;
+        tombstones = 0;
+        compactAt = 0;
+        hashTable.assign(TABLE_SIZE);
+
+        for (int i = 0; i < prevSize; ++i) {
+            if (prevTable.state(i) == OCCUPIED) {
+                insert(prevTable.key(i), prevTable.value(i));
+            }
+        }
+        stats.nResize++;
+    }
+
+    // Chuyển nốt phần còn lại của bảng cũ (nếu đang rehash tăng dần)
+    void finishRehash() {
+        if (isMigrating())
+            migrateStep(oldSize);
+    }
+
+    bool isMigrating() const {
+        return oldSize > 0;
+    }
+
+    double loadFactor() const {
+        return static_cast<double>(keysPresent) / TABLE_SIZE;
+    }
+
+    // Tỷ lệ slot không EMPTY (key + tombstone), quyết định độ dài probe khi search miss
+    double usedLoadFactor() const {
+        return static_cast<double>(keysPresent + tombstones) / TABLE_SIZE;
+    }
+
+    int tombstoneCount() const {
+        return tombstones;
+    }
+
+    int size() const {
+        return TABLE_SIZE;
+    }
+
+    int maxClusterLength() const {
+        return ClusterUtils::maxClusterLength(hashTable.states());
+    }
+
+    double avgClusterLength() const {
+        return ClusterUtils::avgClusterLength(hashTable.states());
+    }
+};
+
+// ======= Các bảng cổ điển =======
+// Tên cũ giữ nguyên dưới dạng alias của OpenAddressTable
+template<typename K, typename V, template<typename, typename> class Slots = AoSSlots, typename Sizing = PrimeSizing, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+using DoubleHashTable = OpenAddressTable<K, V, DoubleProbe, FixedCapacity, Stats, Slots, Sizing, Hasher>;
+
+template<typename K, typename V, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+using LinearHashTable = OpenAddressTable<K, V, LinearProbe, FixedCapacity, Stats, AoSSlots, PrimeSizing, Hasher>;
+
+template<typename K, typename V, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+using QuadraticHashTable = OpenAddressTable<K, V, QuadraticProbe, FixedCapacity, Stats, AoSSlots, PrimeSizing, Hasher>;
+
+template<typename K, typename V, template<typename, typename> class Slots = AoSSlots, typename Sizing = PrimeSizing, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+using DynamicDoubleHashTable = OpenAddressTable<K, V, DoubleProbe, LoadFactorGrowth, Stats, Slots, Sizing, Hasher>;
+
+template<typename K, typename V, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+using DynamicLinearHashTable = OpenAddressTable<K, V, LinearProbe, LoadFactorGrowth, Stats, AoSSlots, PrimeSizing, Hasher>;
+
+template<typename K, typename V, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+using DynamicQuadraticHashTable = OpenAddressTable<K, V, QuadraticProbe, LoadFactorGrowth, Stats, AoSSlots, PrimeSizing, Hasher>;
+
+// ======= SIMD control-byte group =======
+// Mỗi slot có 1 byte điều khiển: EMPTY/DELETED có bit cao = 1,
+// slot đang chứa key lưu tag 7 bit thấp của hash (0..127)
+namespace GroupCtrl {
+    constexpr int8_t EMPTY_CTRL = -128;  // 0b10000000
+    constexpr int8_t DELETED_CTRL = -2;  // 0b11111110
+
+    // So khớp cả nhóm WIDTH byte trong một lệnh, trả về bitmask các vị trí khớp
+    struct Matcher {
+#if defined(__AVX2__)
+        static constexpr int WIDTH = 32;
+
+        static uint32_t match(const int8_t* group, int8_t tag) {
+            __m256i ctrl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group));
+            return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(ctrl, _mm256_set1_epi8(tag))));
+        }
+
+        static uint32_t matchEmptyOrDeleted(const int8_t* group) {
+            __m256i ctrl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(group));
+            return static_cast<uint32_t>(_mm256_movemask_epi8(ctrl));
+        }
+#elif defined(DOUBLE_HASHING_SSE2)
+        static constexpr int WIDTH = 16;
+
+        static uint32_t match(const int8_t* group, int8_t tag) {
+            __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag))));
+        }
+
+        static uint32_t matchEmptyOrDeleted(const int8_t* group) {
+            __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+            return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+        }
+#else
+        static constexpr int WIDTH = 16;
+
+        static uint32_t match(const int8_t* group, int8_t tag) {
+            uint32_t mask = 0;
+            for (int i = 0; i < WIDTH; ++i)
+                if (group[i] == tag) mask |= 1u << i;
+            return mask;
+        }
+
+        static uint32_t matchEmptyOrDeleted(const int8_t* group) {
+            uint32_t mask = 0;
+            for (int i = 0; i < WIDTH; ++i)
+                if (group[i] < 0) mask |= 1u << i;
+            return mask;
+        }
+#endif
+        static uint32_t matchEmpty(const int8_t* group) {
+            return match(group, EMPTY_CTRL);
+        }
+    };
+}
+
+// ======= SIMD Group Double Hashing Table =======
+// Slot được chia thành nhóm GROUP byte điều khiển; double hashing chọn bước nhảy
+// giữa các nhóm, trong một nhóm so khớp tag bằng SIMD. Một probe = một nhóm.
+template<typename K, typename V, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+class GroupDoubleHashTable {
+    static constexpr int GROUP = GroupCtrl::Matcher::WIDTH;
+    int NUM_GROUPS;  // số nhóm, một bậc nguyên tố của PrimeLadder để bước nhảy đi qua mọi nhóm
+    int PRIME;       // số nguyên tố lớn nhất < NUM_GROUPS
+    int TABLE_SIZE;  // = NUM_GROUPS * GROUP
+    int keysPresent;
+    int tombstones;
+    Hasher hasher;
+    helper::FastMod modGroups, modPrime;
+    std::vector<int8_t> ctrl;
+    std::vector<K> keys;
+    std::vector<V> values;
+
+    // Đặt key chắc chắn chưa có vào slot trống đầu tiên, không cập nhật thống kê
+    void place(const K& key, const V& value) {
+        uint64_t h = hasher(key);
+        int group = groupOf(h);
+        int offset = strideOf(h);
+        uint32_t free;
+        while (!(free = GroupCtrl::Matcher::matchEmptyOrDeleted(&ctrl[group * GROUP])))
+            group = helper::addMod(group, offset, NUM_GROUPS);
+        int i = group * GROUP + std::countr_zero(free);
+        ctrl[i] = tag(h);
+        keys[i] = key;
+        values[i] = value;
+    }
+
+public:
+    Stats stats;
+
+    // Số nhóm cho n slot: bậc nhỏ nhất đủ chứa n, nhưng không để NUM_GROUPS * GROUP vượt INT_MAX
+    static constexpr const PrimeLadder::Rung& groupRung(long long n) {
+        constexpr long long MAX_GROUPS = std::numeric_limits<int>::max() / GROUP;
+        long long minGroups = std::max(1LL, (n + GROUP - 1) / GROUP);
+        if (PrimeLadder::atLeast(minGroups).size > MAX_GROUPS)
+            return PrimeLadder::atMost(MAX_GROUPS);
+        return PrimeLadder::atLeast(minGroups);
+    }
+
+    GroupDoubleHashTable(int n) {
+        const PrimeLadder::Rung& rung = groupRung(n);
+        NUM_GROUPS = rung.size;
+        PRIME = rung.prime;
+        TABLE_SIZE = NUM_GROUPS * GROUP;
+        keysPresent = 0;
+        tombstones = 0;
+        modGroups = rung.modSize;
+        modPrime = rung.modPrime;
+        ctrl.assign(TABLE_SIZE, GroupCtrl::EMPTY_CTRL);
+        keys.assign(TABLE_SIZE, K());
+        values.assign(TABLE_SIZE, V());
+    }
+
+    // Nhóm gốc và bước nhảy (tính theo nhóm) từ hash 64 bit đã có
+    int groupOf(uint64_t h) const {
+        return modGroups.mod(helper::lo32(h));
+    }
+
+    int strideOf(uint64_t h) const {
+        return PRIME - modPrime.mod(helper::hi32(h));
+    }
+
+    // Cùng giao diện hash1/hash2 theo key với các bảng khác, đơn vị là nhóm thay vì slot
+    int hash1(const K& key) const {
+        return groupOf(hasher(key));
+    }
+
+    int hash2(const K& key) const {
+        return strideOf(hasher(key));
+    }
+
+    // Tag lấy 7 bit cao sau phép nhân Fibonacci, độc lập với chỉ số nhóm
+    static int8_t tag(uint64_t h) {
+        return static_cast<int8_t>((h * 0x9E3779B97F4A7C15ull) >> 57);
+    }
+
+    bool isFull() {
+        return keysPresent == TABLE_SIZE;
+    }
+
+    bool insert(const K& key, const V& value) {
+        typename Stats::OpScope scope(stats, HIST_INSERT, stats.totalProbesInsert);
+        if (isFull()) return false;
+        uint64_t h = hasher(key);
+        int8_t t = tag(h);
+        int group = groupOf(h);
+        int offset = strideOf(h);
+        int homeGroup = group;
+        int target = -1;
+        int probes = 0;
+        for (int step = 0; step < NUM_GROUPS; ++step) {
+            const int8_t* g = &ctrl[group * GROUP];
+            probes++;
+            for (uint32_t m = GroupCtrl::Matcher::match(g, t); m; m &= m - 1) {
+                int i = group * GROUP + std::countr_zero(m);
+                if (keys[i] == key) {
+                    values[i] = value;
+                    return true;
+                }
+            }
+            if (target < 0) {
+                uint32_t free = GroupCtrl::Matcher::matchEmptyOrDeleted(g);
+                if (free) target = group * GROUP + std::countr_zero(free);
+            }
+            if (GroupCtrl::Matcher::matchEmpty(g))
+                break;
+            group = helper::addMod(group, offset, NUM_GROUPS);
+        }
+        if (target < 0) return false;
+        // Va chạm: nhóm gốc đã đầy, key phải sang nhóm khác
+        if (target / GROUP != homeGroup)
+            stats.totalCollision++;
+        if (ctrl[target] == GroupCtrl::DELETED_CTRL)
+            tombstones--;
+        ctrl[target] = t;
+        keys[target] = key;
+        values[target] = value;
+        keysPresent++;
+        stats.totalProbesInsert += probes;
+        stats.nInsert++;
+        return true;
+    }
+
+    bool search(const K& key, V& outValue) {
+        typename Stats::OpScope scope(stats, HIST_SEARCH_MISS, stats.totalProbesSearch);
+        uint64_t h = hasher(key);
+        int8_t t = tag(h);
+        int group = groupOf(h);
+        int offset = strideOf(h);
+        int probes = 0;
+        for (int step = 0; step < NUM_GROUPS; ++step) {
+            const int8_t* g = &ctrl[group * GROUP];
+            probes++;
+            for (uint32_t m = GroupCtrl::Matcher::match(g, t); m; m &= m - 1) {
+                int i = group * GROUP + std::countr_zero(m);
+                if (keys[i] == key) {
+                    outValue = values[i];
+                    stats.totalProbesSearch += probes;
+                    stats.nSearch++;
+                    scope.markHit();
+                    return true;
+                }
+            }
+            if (GroupCtrl::Matcher::matchEmpty(g))
+                break;
+            group = helper::addMod(group, offset, NUM_GROUPS);
+        }
+        stats.totalProbesSearch += probes;
+        stats.nSearch++;
+        return false;
+    }
+
+    void erase(const K& key) {
+        typename Stats::OpScope scope(stats, HIST_ERASE, stats.totalProbesDelete);
+        uint64_t h = hasher(key);
+        int8_t t = tag(h);
+        int group = groupOf(h);
+        int offset = strideOf(h);
+        int probes = 0;
+        for (int step = 0; step < NUM_GROUPS; ++step) {
+            const int8_t* g = &ctrl[group * GROUP];
+            probes++;
+            for (uint32_t m = GroupCtrl::Matcher::match(g, t); m; m &= m - 1) {
+                int i = group * GROUP + std::countr_zero(m);
+                if (keys[i] == key) {
+                    // Nhóm còn slot EMPTY thì chưa probe nào đi qua nó, có thể trả về EMPTY
+                    if (GroupCtrl::Matcher::matchEmpty(g)) {
+                        ctrl[i] = GroupCtrl::EMPTY_CTRL;
+                    }
+                    else {
+                        ctrl[i] = GroupCtrl::DELETED_CTRL;
+                        tombstones++;
+                    }
+                    keysPresent--;
+                    stats.totalProbesDelete += probes;
+                    stats.nDelete++;
+                    if (tombstones > TombstoneUtils::MAX_TOMBSTONE_RATIO * TABLE_SIZE)
+                        compact();
+                    return;
+                }
+            }
+            if (GroupCtrl::Matcher::matchEmpty(g))
+                break;
+            group = helper::addMod(group, offset, NUM_GROUPS);
+        }
+        stats.totalProbesDelete += probes;
+        stats.nDelete++;
+    }
+
+    // Dựng lại mảng điều khiển cùng kích thước để xoá mọi tombstone
+    void compact() {
+        typename Stats::OpScope scope(stats, HIST_REHASH, stats.totalProbesInsert);
+        std::vector<int8_t> oldCtrl = std::move(ctrl);
+        std::vector<K> oldKeys = std::move(keys);
+        std::vector<V> oldValues = std::move(values);
+        ctrl.assign(TABLE_SIZE, GroupCtrl::EMPTY_CTRL);
+        keys.assign(TABLE_SIZE, K());
+        values.assign(TABLE_SIZE, V());
+        for (int i = 0; i < TABLE_SIZE; ++i)
+            if (oldCtrl[i] >= 0)
+                place(oldKeys[i], oldValues[i]);
+        tombstones = 0;
+        stats.nCompact++;
+    }
+
+    // Tỷ lệ slot không EMPTY (key + tombstone), quyết định độ dài probe khi search miss
+    double usedLoadFactor() const {
+        return static_cast<double>(keysPresent + tombstones) / TABLE_SIZE;
+    }
+
+    int tombstoneCount() const {
+        return tombstones;
+    }
+
+    int maxClusterLength() const {
+        return ClusterUtils::maxClusterLength(ctrl);
+    }
+
+    double avgClusterLength() const {
+        return ClusterUtils::avgClusterLength(ctrl);
+    }
+
+    double loadFactor() const {
+        return static_cast<double>(keysPresent) / TABLE_SIZE;
+    }
+
+    int size() const {
+        return TABLE_SIZE;
+    }
+};
+
+// ======= Robin Hood Double Hashing Table =======
+// Dãy probe giống DoubleHashTable, nhưng insert giành slot của entry "giàu" hơn (dist nhỏ hơn)
+// rồi mang entry bị đẩy ra đi tiếp trên dãy của chính nó. dist của một slot vì vậy không bao giờ
+// giảm, nên search dừng ngay khi gặp slot có dist nhỏ hơn số bước đã đi: key không thể nằm xa hơn.
+// Xóa để lại tombstone giữ nguyên dist để bất biến trên vẫn đúng.
+template<typename K, typename V, typename Sizing = PrimeSizing, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+class RobinHoodHashTable {
+    int TABLE_SIZE;
+    int keysPresent;
+    int tombstones;
+    Hasher hasher;
+    Sizing sizing;
+    std::vector<RobinHoodEntry<K, V>> hashTable;
+
+    // Đặt key vào slot probe (bước dist trên dãy của nó), đẩy dần các entry giàu hơn về sau.
+    // Trả về số slot đã chạm. Nếu một entry đi hết vòng mà không có chỗ (mọi tombstone đều
+    // có dist lớn hơn) thì đặt nó vào slot trống bất kỳ và báo overflow để caller dựng lại bảng
+    int place(K key, V value, int probe, int offset, int dist, bool& overflow) {
+        int probes = 0;
+        int walked = 0;
+        while (true) {
+            probes++;
+            RobinHoodEntry<K, V>& slot = hashTable[probe];
+            int targetIdx = -1;
+            if (slot.state == EMPTY || (slot.state == DELETED && slot.dist <= dist))
+                targetIdx = probe;
+            else if (walked >= TABLE_SIZE) {
+                targetIdx = probe;
+                while (hashTable[targetIdx].state == OCCUPIED)
+                    targetIdx = helper::addMod(targetIdx, 1, TABLE_SIZE);
+                overflow = true;
+            }
+            if (targetIdx >= 0) {
+                RobinHoodEntry<K, V>& target = hashTable[targetIdx];
+                if (target.state == DELETED)
+                    tombstones--;
+                target.key = std::move(key);
+                target.value = std::move(value);
+                target.dist = dist;
+                target.state = OCCUPIED;
+                return probes;
+            }
+            if (slot.state == OCCUPIED && slot.dist < dist) {
+                std::swap(key, slot.key);
+                std::swap(value, slot.value);
+                std::swap(dist, slot.dist);
+                offset = sizing.stride(hasher(key));
+                walked = 0;
+            }
+            probe = sizing.next(probe, offset);
+            dist++;
+            walked++;
+        }
+    }
+
+public:
+    Stats stats;
+
+    RobinHoodHashTable(int n) {
+        sizing.init(n);
+        TABLE_SIZE = sizing.TABLE_SIZE;
+        keysPresent = 0;
+        tombstones = 0;
+        hashTable.assign(TABLE_SIZE, RobinHoodEntry<K, V>());
+    }
+
+    bool isFull() {
+        return keysPresent == TABLE_SIZE;
+    }
+
+    bool insert(const K& key, const V& value) {
+        typename Stats::OpScope scope(stats, HIST_INSERT, stats.totalProbesInsert);
+        if (isFull()) return false;
+        uint64_t h = hasher(key);
+        int probe = sizing.home(h);
+        int offset = sizing.stride(h);
+        int probes = 0;
+        if (hashTable[probe].state == OCCUPIED)
+            stats.totalCollision++;
+        // Đi trên dãy của key tới khi chắc key chưa có: slot EMPTY hoặc slot giàu hơn
+        int dist = 0;
+        for (; dist < TABLE_SIZE; ++dist) {
+            probes++;
+            RobinHoodEntry<K, V>& slot = hashTable[probe];
+            if (slot.state == EMPTY || slot.dist < dist)
+                break;
+            if (slot.state == OCCUPIED && slot.key == key) {
+                slot.value = value;
+                return true;
+            }
+            probe = sizing.next(probe, offset);
+        }
+        bool overflow = false;
+        probes += place(key, value, probe, offset, dist, overflow) - 1;  // slot dừng đã được đếm
+        keysPresent++;
+        stats.totalProbesInsert += probes;
+        stats.nInsert++;
+        if (overflow)
+            compact();
+        return true;
+    }
+
+    bool search(const K& key, V& outValue) {
+        typename Stats::OpScope scope(stats, HIST_SEARCH_MISS, stats.totalProbesSearch);
+        uint64_t h = hasher(key);
+        int probe = sizing.home(h);
+        int offset = sizing.stride(h);
+        int probes = 0;
+        for (int dist = 0; dist < TABLE_SIZE; ++dist) {
+            probes++;
+            const RobinHoodEntry<K, V>& slot = hashTable[probe];
+            if (slot.state == EMPTY || slot.dist < dist)
+                break;
+            if (slot.state == OCCUPIED && slot.key == key) {
+                outValue = slot.value;
+                stats.totalProbesSearch += probes;
+                stats.nSearch++;
+                scope.markHit();
+                return true;
+            }
+            probe = sizing.next(probe, offset);
+        }
+        stats.totalProbesSearch += probes;
+        stats.nSearch++;
+        return false;
+    }
+
+    void erase(const K& key) {
+        typename Stats::OpScope scope(stats, HIST_ERASE, stats.totalProbesDelete);
+        uint64_t h = hasher(key);
+        int probe = sizing.home(h);
+        int offset = sizing.stride(h);
+        int probes = 0;
+        for (int dist = 0; dist < TABLE_SIZE; ++dist) {
+            probes++;
+            RobinHoodEntry<K, V>& slot = hashTable[probe];
+            if (slot.state == EMPTY || slot.dist < dist)
+                break;
+            if (slot.state == OCCUPIED && slot.key == key) {
+                slot.state = DELETED;
+                keysPresent--;
+                tombstones++;
+                stats.totalProbesDelete += probes;
+                stats.nDelete++;
+                if (tombstones > TombstoneUtils::MAX_TOMBSTONE_RATIO * TABLE_SIZE)
+                    compact();
+                return;
+            }
+            probe = sizing.next(probe, offset);
+        }
+        stats.totalProbesDelete += probes;
+        stats.nDelete++;
+    }
+
+    // Dựng lại bảng cùng kích thước, bỏ hết tombstone (dist của chúng không thể đặt lại tại chỗ)
+    void compact() {
+        typename Stats::OpScope scope(stats, HIST_REHASH, stats.totalProbesInsert);
+        std::vector<RobinHoodEntry<K, V>> old(TABLE_SIZE);
+        old.swap(hashTable);
+        tombstones = 0;
+        bool overflow = false;
+        for (auto& entry : old) {
+            if (entry.state != OCCUPIED) continue;
+            uint64_t h = hasher(entry.key);
+            place(std::move(entry.key), std::move(entry.value), sizing.home(h), sizing.stride(h), 0, overflow);
+        }
+        stats.nCompact++;
+    }
+
+    double loadFactor() const {
+        return static_cast<double>(keysPresent) / TABLE_SIZE;
+    }
+
+    // Tỷ lệ slot không EMPTY (key + tombstone)
+    double usedLoadFactor() const {
+        return static_cast<double>(keysPresent + tombstones) / TABLE_SIZE;
+    }
+
+    int tombstoneCount() const {
+        return tombstones;
+    }
+
+    int size() const {
+        return TABLE_SIZE;
+    }
+
+    // dist lớn nhất của các key đang có = số probe tối đa - 1 của một search HIT
+    int maxDistance() const {
+        int maxDist = 0;
+        for (const auto& entry : hashTable)
+            if (entry.state == OCCUPIED)
+                maxDist = std::max(maxDist, entry.dist);
+        return maxDist;
+    }
+
+    double avgDistance() const {
+        long long total = 0;
+        for (const auto& entry : hashTable)
+            if (entry.state == OCCUPIED)
+                total += entry.dist;
+        return keysPresent ? 1.0 * total / keysPresent : 0;
+    }
+
+    int maxClusterLength() const {
+        return ClusterUtils::maxClusterLength(hashTable);
+    }
 
     double avgClusterLength() const {
         return ClusterUtils::avgClusterLength(hashTable);
     }
 };
 
-// ======= Quadratic Probing Table =======
-template<typename K, typename V>
-class QuadraticHashTable {
+// ======= Bucketized Cuckoo Table =======
+// Mỗi key có đúng 2 bucket ứng viên (hash1 từ 32 bit thấp, hash2 từ 32 bit cao), mỗi bucket là
+// một CacheLineBucket. Search chạm tối đa 2 dòng cache cộng một stash nhỏ, không phụ thuộc
+// load factor. Insert khi cả 2 bucket đầy tìm đường đẩy (BFS, tối đa MAX_PATH bước)
+// tới một bucket còn chỗ rồi mới di chuyển, nên thất bại không làm mất key nào; không có đường
+// thì key vào stash. Probe được đếm theo số bucket (dòng cache) đã chạm, stash tính là 1.
+template<typename K, typename V, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+class CuckooHashTable {
+public:
+    using Bucket = CacheLineBucket<K, V>;
+    static_assert(sizeof(Bucket) == 64, "mỗi bucket phải đúng một dòng cache: key + value quá lớn");
+    // Chỉ 2 bucket ứng viên: bucket 1-3 slot làm cuckoo đầy sớm và phải đẩy key liên tục
+    static_assert(Bucket::SLOTS >= Bucket::MIN_WIDE_SLOTS, "cuckoo cần >= 4 slot mỗi bucket: key + value quá lớn");
+    static constexpr int SLOTS = Bucket::SLOTS;
+    static constexpr int STASH_SIZE = 8;
+    static constexpr int MAX_PATH = 5;          // số lần đẩy tối đa trên một đường
+    static constexpr int MAX_BFS_NODES = 512;
+    static constexpr int BATCH_WINDOW = 16;
+
+private:
+    int NUM_BUCKETS;
+    int keysPresent;
+    Hasher hasher;
+    helper::FastMod modBuckets;
+    std::vector<Bucket> buckets;
+    std::vector<std::pair<K, V>> stash;
+
+    int bucket1(uint64_t h) const {
+        return modBuckets.mod(helper::lo32(h));
+    }
+
+    // Bucket thứ hai luôn khác bucket đầu
+    int bucket2(uint64_t h) const {
+        int b1 = bucket1(h);
+        int b2 = modBuckets.mod(helper::hi32(h));
+        return b2 != b1 ? b2 : helper::addMod(b1, 1, NUM_BUCKETS);
+    }
+
+    int alternate(const K& key, int bucket) const {
+        uint64_t h = hasher(key);
+        int b1 = bucket1(h);
+        return bucket == b1 ? bucket2(h) : b1;
+    }
+
+    int findStash(const K& key) const {
+        for (size_t i = 0; i < stash.size(); ++i)
+            if (stash[i].first == key) return int(i);
+        return -1;
+    }
+
+    struct PathNode {
+        int bucket;
+        int parent;  // chỉ số node cha trong hàng đợi, -1 với 2 bucket gốc
+        int slot;    // slot ở bucket cha mà key trong đó chuyển sang bucket này
+        int depth;
+    };
+
+    // BFS từ 2 bucket ứng viên tới bucket còn chỗ, dời các key dọc đường từ cuối về đầu.
+    // Trả về bucket gốc đã có slot trống, -1 nếu không tìm được đường; probes += số bucket đã xét
+    int makeRoom(int b1, int b2, int& probes) {
+        std::vector<PathNode> nodes;
+        nodes.reserve(MAX_BFS_NODES);
+        nodes.push_back({ b1, -1, -1, 0 });
+        nodes.push_back({ b2, -1, -1, 0 });
+        for (size_t head = 0; head < nodes.size(); ++head) {
+            PathNode node = nodes[head];
+            probes++;
+            if (!buckets[node.bucket].full()) {
+                // Dời từ cuối đường về gốc: key ở (cha, slot) sang slot trống của bucket con
+                int cur = int(head);
+                while (nodes[cur].parent >= 0) {
+                    const PathNode& child = nodes[cur];
+                    Bucket& from = buckets[nodes[child.parent].bucket];
+                    Bucket& to = buckets[child.bucket];
+                    int dst = to.freeSlot();
+                    to.keys[dst] = std::move(from.keys[child.slot]);
+                    to.values[dst] = std::move(from.values[child.slot]);
+                    to.occupied |= uint8_t(1u << dst);
+                    from.occupied &= uint8_t(~(1u << child.slot));
+                    cur = child.parent;
+                }
+                return nodes[cur].bucket;
+            }
+            if (node.depth >= MAX_PATH) continue;
+            for (int i = 0; i < SLOTS && nodes.size() < size_t(MAX_BFS_NODES); ++i) {
+                int alt = alternate(buckets[node.bucket].keys[i], node.bucket);
+                // Bỏ đường vòng: bucket đã nằm trên đường từ gốc tới node
+                bool onPath = false;
+                for (int a = int(head); a >= 0 && !onPath; a = nodes[a].parent)
+                    onPath = nodes[a].bucket == alt;
+                if (!onPath)
+                    nodes.push_back({ alt, int(head), i, node.depth + 1 });
+            }
+        }
+        return -1;
+    }
+
+    // Sau khi xóa khỏi bucket, đưa key trong stash về bucket của nó nếu vừa có chỗ
+    void drainStash(int bucket) {
+        for (size_t i = 0; i < stash.size() && !buckets[bucket].full(); ) {
+            uint64_t h = hasher(stash[i].first);
+            if (bucket1(h) == bucket || bucket2(h) == bucket) {
+                Bucket& b = buckets[bucket];
+                int slot = b.freeSlot();
+                b.keys[slot] = std::move(stash[i].first);
+                b.values[slot] = std::move(stash[i].second);
+                b.occupied |= uint8_t(1u << slot);
+                stash[i] = std::move(stash.back());
+                stash.pop_back();
+            }
+            else ++i;
+        }
+    }
+
+    bool searchHashed(const K& key, uint64_t h, V& outValue) {
+        int probes = 1;
+        const Bucket& first = buckets[bucket1(h)];
+        int slot = first.find(key);
+        if (slot >= 0) {
+            outValue = first.values[slot];
+        }
+        else {
+            probes++;
+            const Bucket& second = buckets[bucket2(h)];
+            slot = second.find(key);
+            if (slot >= 0) {
+                outValue = second.values[slot];
+            }
+            else if (!stash.empty()) {
+                probes++;
+                slot = findStash(key);
+                if (slot >= 0)
+                    outValue = stash[slot].second;
+            }
+        }
+        stats.totalProbesSearch += probes;
+        stats.nSearch++;
+        return slot >= 0;
+    }
+
+public:
+    Stats stats;
+
+    // n: số slot mong muốn, làm tròn lên bội của SLOTS
+    CuckooHashTable(int n) {
+        NUM_BUCKETS = std::max(2, (n + SLOTS - 1) / SLOTS);
+        keysPresent = 0;
+        modBuckets = helper::FastMod(NUM_BUCKETS);
+        buckets.assign(NUM_BUCKETS, Bucket());
+        stash.reserve(STASH_SIZE);
+    }
+
+    bool isFull() {
+        return keysPresent == size() + STASH_SIZE;
+    }
+
+    bool insert(const K& key, const V& value) {
+        typename Stats::OpScope scope(stats, HIST_INSERT, stats.totalProbesInsert);
+        uint64_t h = hasher(key);
+        int b1 = bucket1(h), b2 = bucket2(h);
+        // Cập nhật nếu key đã có (2 bucket + stash)
+        for (int b : { b1, b2 }) {
+            int slot = buckets[b].find(key);
+            if (slot >= 0) {
+                buckets[b].values[slot] = value;
+                return true;
+            }
+        }
+        int inStash = stash.empty() ? -1 : findStash(key);
+        if (inStash >= 0) {
+            stash[inStash].second = value;
+            return true;
+        }
+
+        int probes = 2;
+        int target = -1;
+        if (buckets[b1].full()) {
+            stats.totalCollision++;
+            target = buckets[b2].full() ? makeRoom(b1, b2, probes) : b2;
+        }
+        else {
+            target = b1;
+        }
+        if (target >= 0) {
+            Bucket& b = buckets[target];
+            int slot = b.freeSlot();
+            b.keys[slot] = key;
+            b.values[slot] = value;
+            b.occupied |= uint8_t(1u << slot);
+        }
+        else if (int(stash.size()) < STASH_SIZE) {
+            stash.emplace_back(key, value);
+            probes++;
+        }
+        else {
+            return false;
+        }
+        keysPresent++;
+        stats.totalProbesInsert += probes;
+        stats.nInsert++;
+        return true;
+    }
+
+    bool search(const K& key, V& outValue) {
+        typename Stats::OpScope scope(stats, HIST_SEARCH_MISS, stats.totalProbesSearch);
+        if (!searchHashed(key, hasher(key), outValue))
+            return false;
+        scope.markHit();
+        return true;
+    }
+
+    // Vị trí của mọi key đã biết trước khi đọc bảng: prefetch cả 2 bucket của cả cửa sổ
+    void search_batch(const std::vector<K>& keys, std::vector<V>& outValues, std::vector<bool>& found) {
+        int n = static_cast<int>(keys.size());
+        outValues.resize(n);
+        found.assign(n, false);
+        uint64_t hs[BATCH_WINDOW];
+        for (int base = 0; base < n; base += BATCH_WINDOW) {
+            int cnt = std::min(BATCH_WINDOW, n - base);
+            for (int j = 0; j < cnt; ++j) {
+                hs[j] = hasher(keys[base + j]);
+                prefetchRead(&buckets[bucket1(hs[j])]);
+                prefetchRead(&buckets[bucket2(hs[j])]);
+            }
+            for (int j = 0; j < cnt; ++j) {
+                V v;
+                if (searchHashed(keys[base + j], hs[j], v)) {
+                    outValues[base + j] = v;
+                    found[base + j] = true;
+                }
+            }
+        }
+    }
+
+    void erase(const K& key) {
+        typename Stats::OpScope scope(stats, HIST_ERASE, stats.totalProbesDelete);
+        uint64_t h = hasher(key);
+        int probes = 0;
+        for (int b : { bucket1(h), bucket2(h) }) {
+            probes++;
+            int slot = buckets[b].find(key);
+            if (slot >= 0) {
+                buckets[b].occupied &= uint8_t(~(1u << slot));
+                keysPresent--;
+                if (!stash.empty())
+                    drainStash(b);
+                stats.totalProbesDelete += probes;
+                stats.nDelete++;
+                return;
+            }
+        }
+        if (!stash.empty()) {
+            probes++;
+            int i = findStash(key);
+            if (i >= 0) {
+                stash[i] = std::move(stash.back());
+                stash.pop_back();
+                keysPresent--;
+            }
+        }
+        stats.totalProbesDelete += probes;
+        stats.nDelete++;
+    }
+
+    double loadFactor() const {
+        return static_cast<double>(keysPresent) / size();
+    }
+
+    // Số slot trong các bucket (không tính stash)
+    int size() const {
+        return NUM_BUCKETS * SLOTS;
+    }
+
+    int bucketCount() const {
+        return NUM_BUCKETS;
+    }
+
+    int stashSize() const {
+        return int(stash.size());
+    }
+};
+
+// ======= Hopscotch Hashing Table =======
+// Mỗi key nằm trong H slot tính từ slot gốc của nó, ghi nhận bằng bitmap hop ở slot gốc.
+// Search chỉ so sánh các slot có bit bật (không phụ thuộc load factor, thường trong 1-2 dòng cache).
+// Insert dò tuyến tính tới slot trống rồi "nhảy lò cò" kéo slot trống về gần slot gốc bằng cách dời
+// các key có vùng lân cận chứa slot trống; không dời được thì bảng coi như đầy.
+// Xóa chỉ tắt bit và trả slot về EMPTY, không cần tombstone.
+template<typename K, typename V, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+class HopscotchHashTable {
+public:
+    static constexpr int H = 32;  // độ rộng vùng lân cận = số bit của hop
+
+private:
     int TABLE_SIZE;
+    int HOP;  // min(H, TABLE_SIZE) để vùng lân cận không quấn lại chính nó
     int keysPresent;
-    std::vector<Entry<K, V>> hashTable;
+    Hasher hasher;
+    helper::FastMod modSize;
+    std::vector<HopscotchEntry<K, V>> hashTable;
+
+    int subMod(int a, int b) const {
+        int d = a - b;
+        return d < 0 ? d + TABLE_SIZE : d;
+    }
+
+    // Slot chứa key trong vùng lân cận của home, -1 nếu không có; probes += số key đã so sánh
+    int find(const K& key, int home, int& probes) const {
+        for (uint32_t bits = hashTable[home].hop; bits; bits &= bits - 1) {
+            int slot = helper::addMod(home, std::countr_zero(bits), TABLE_SIZE);
+            probes++;
+            if (hashTable[slot].key == key)
+                return slot;
+        }
+        return -1;
+    }
+
+    // Dời một key sang slot trống free (khoảng cách tới free < HOP), ưu tiên bucket xa nhất
+    // để slot trống lùi được nhiều nhất. Trả về slot trống mới, -1 nếu không dời được
+    int hopBack(int free) {
+        for (int back = HOP - 1; back > 0; --back) {
+            int bucket = subMod(free, back);
+            uint32_t before = hashTable[bucket].hop & ((1u << back) - 1);
+            if (!before) continue;
+            int off = std::countr_zero(before);
+            int from = helper::addMod(bucket, off, TABLE_SIZE);
+            hashTable[free].key = std::move(hashTable[from].key);
+            hashTable[free].value = std::move(hashTable[from].value);
+            hashTable[free].state = OCCUPIED;
+            hashTable[from].state = EMPTY;
+            hashTable[bucket].hop = (hashTable[bucket].hop & ~(1u << off)) | (1u << back);
+            return from;
+        }
+        return -1;
+    }
+
 public:
-    HashStats stats;
+    Stats stats;
 
-    QuadraticHashTable(int n) {
+    HopscotchHashTable(int n) {
         TABLE_SIZE = n;
+        HOP = std::min(H, TABLE_SIZE);
         keysPresent = 0;
-        hashTable.assign(TABLE_SIZE, Entry<K, V>());
+        modSize = helper::FastMod(TABLE_SIZE);
+        hashTable.assign(TABLE_SIZE, HopscotchEntry<K, V>());
     }
 
-    int hash(const K& key) {
-        return std::hash<K>{}(key) % TABLE_SIZE;
+    int hash(const K& key) const {
+        return modSize.mod(helper::lo32(hasher(key)));
     }
 
     bool isFull() {
@@ -373,244 +2506,641 @@ public:
     }
 
     bool insert(const K& key, const V& value) {
+        typename Stats::OpScope scope(stats, HIST_INSERT, stats.totalProbesInsert);
+        int home = hash(key);
+        int probes = 0;
+        int slot = find(key, home, probes);
+        if (slot >= 0) {
+            hashTable[slot].value = value;
+            return true;
+        }
         if (isFull()) return false;
-        int base = hash(key);
-        int i = 0;
+        if (hashTable[home].state == OCCUPIED)
+            stats.totalCollision++;
+
+        // Dò tuyến tính tới slot trống đầu tiên
+        int free = home;
+        int dist = 0;
+        while (hashTable[free].state == OCCUPIED) {
+            probes++;
+            free = helper::addMod(free, 1, TABLE_SIZE);
+            dist++;
+        }
+        probes++;
+        // Kéo slot trống về trong vùng lân cận của home
+        while (dist >= HOP) {
+            int moved = hopBack(free);
+            if (moved < 0) return false;
+            dist -= subMod(free, moved);
+            free = moved;
+        }
+        hashTable[free].key = key;
+        hashTable[free].value = value;
+        hashTable[free].state = OCCUPIED;
+        hashTable[home].hop |= 1u << dist;
+        keysPresent++;
+        stats.totalProbesInsert += probes;
+        stats.nInsert++;
+        return true;
+    }
+
+    bool search(const K& key, V& outValue) {
+        typename Stats::OpScope scope(stats, HIST_SEARCH_MISS, stats.totalProbesSearch);
+        int probes = 0;
+        int slot = find(key, hash(key), probes);
+        stats.totalProbesSearch += std::max(probes, 1);  // bitmap rỗng vẫn tính 1 lần đọc slot gốc
+        stats.nSearch++;
+        if (slot < 0)
+            return false;
+        outValue = hashTable[slot].value;
+        scope.markHit();
+        return true;
+    }
+
+    void erase(const K& key) {
+        typename Stats::OpScope scope(stats, HIST_ERASE, stats.totalProbesDelete);
+        int home = hash(key);
+        int probes = 0;
+        int slot = find(key, home, probes);
+        if (slot >= 0) {
+            hashTable[slot].state = EMPTY;
+            hashTable[home].hop &= ~(1u << subMod(slot, home));
+            keysPresent--;
+        }
+        stats.totalProbesDelete += std::max(probes, 1);
+        stats.nDelete++;
+    }
+
+    double loadFactor() const {
+        return static_cast<double>(keysPresent) / TABLE_SIZE;
+    }
+
+    int size() const {
+        return TABLE_SIZE;
+    }
+
+    int maxClusterLength() const {
+        return ClusterUtils::maxClusterLength(hashTable);
+    }
+
+    double avgClusterLength() const {
+        return ClusterUtils::avgClusterLength(hashTable);
+    }
+};
+
+// ======= Bucketized Double Hashing Table =======
+// Double hashing trên các bucket 64 byte: hash1 chọn bucket gốc, hash2 chọn bước nhảy giữa các
+// bucket, trong một bucket mọi slot được xét với một lần nạp dòng cache. Không có tombstone:
+// mỗi bucket đếm số key đã đi qua nó vì nó đầy (overflow); search dừng ở bucket đầu tiên có
+// overflow = 0, erase giảm overflow dọc đường của key bị xóa (bão hòa ở 255 thì giữ nguyên).
+// Insert bỏ qua bucket đầy chỉ bằng mask, không đọc key. Probe được đếm theo số bucket đã chạm.
+template<typename K, typename V, typename Sizing = PrimeSizing, typename Hasher = HashUtils::MixHash<K>, typename Stats = HashStats>
+class BucketDoubleHashTable {
+public:
+    using Bucket = CacheLineBucket<K, V>;
+    // Không đòi MIN_WIDE_SLOTS: bucket hẹp (tới 1 slot) vẫn đúng vì dãy bucket của double
+    // hashing đi qua mọi bucket, chỉ mất dần lợi thế quét nhiều slot trong một dòng cache
+    static_assert(sizeof(Bucket) == 64, "mỗi bucket phải đúng một dòng cache: key + value quá lớn");
+    static constexpr int SLOTS = Bucket::SLOTS;
+    static constexpr int BATCH_WINDOW = 16;
+
+private:
+    int NUM_BUCKETS;
+    int keysPresent;
+    Hasher hasher;
+    Sizing sizing;
+    std::vector<Bucket> buckets;
+
+    bool searchHashed(const K& key, uint64_t h, V& outValue) {
+        int b = sizing.home(h);
+        int offset = sizing.stride(h);
         int probes = 0;
-        while (i < TABLE_SIZE) {
-            int probe = (base + i * i) % TABLE_SIZE;
+        bool found = false;
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
             probes++;
-            if (i == 0 && hashTable[probe].state == OCCUPIED)
-                stats.totalCollision++;
-            if (hashTable[probe].state == EMPTY || hashTable[probe].state == DELETED) {
-                hashTable[probe] = Entry<K, V>(key, value, OCCUPIED);
-                keysPresent++;
-                stats.totalProbesInsert += probes;
-                stats.nInsert++;
-                return true;
-            } else if (hashTable[probe].key == key) {
-                hashTable[probe].value = value;
+            const Bucket& bucket = buckets[b];
+            int slot = bucket.find(key);
+            if (slot >= 0) {
+                outValue = bucket.values[slot];
+                found = true;
+                break;
+            }
+            if (bucket.overflow == 0)
+                break;
+            b = sizing.next(b, offset);
+        }
+        stats.totalProbesSearch += probes;
+        stats.nSearch++;
+        return found;
+    }
+
+public:
+    Stats stats;
+
+    // n: số slot mong muốn; Sizing chọn số bucket hợp lệ nhỏ nhất đủ chứa n (bậc PrimeLadder
+    // hoặc lũy thừa của 2) để bước nhảy đi qua mọi bucket
+    BucketDoubleHashTable(int n) {
+        int nb = std::max(2, (n + SLOTS - 1) / SLOTS);
+        sizing.grow(nb);
+        NUM_BUCKETS = sizing.TABLE_SIZE;
+        keysPresent = 0;
+        buckets.assign(NUM_BUCKETS, Bucket());
+    }
+
+    bool isFull() {
+        return keysPresent == size();
+    }
+
+    bool insert(const K& key, const V& value) {
+        typename Stats::OpScope scope(stats, HIST_INSERT, stats.totalProbesInsert);
+        uint64_t h = hasher(key);
+        int home = sizing.home(h);
+        int offset = sizing.stride(h);
+        int probes = 0;
+        if (buckets[home].full())
+            stats.totalCollision++;
+
+        // Đi như search để cập nhật nếu key đã có, nhớ bucket chưa đầy đầu tiên
+        int b = home;
+        int target = -1, targetStep = 0;
+        int step = 0;
+        for (; step < NUM_BUCKETS; ++step) {
+            probes++;
+            Bucket& bucket = buckets[b];
+            int slot = bucket.find(key);
+            if (slot >= 0) {
+                bucket.values[slot] = value;
                 return true;
             }
-            i++;
+            if (target < 0 && !bucket.full()) {
+                target = b;
+                targetStep = step;
+            }
+            if (bucket.overflow == 0)
+                break;
+            b = sizing.next(b, offset);
         }
-        return false;
+        if (isFull()) return false;
+        // Key chưa có: nếu mọi bucket đã qua đều đầy, đi tiếp và chỉ xem mask
+        while (target < 0 && ++step < NUM_BUCKETS) {
+            b = sizing.next(b, offset);
+            probes++;
+            if (!buckets[b].full()) {
+                target = b;
+                targetStep = step;
+            }
+        }
+        if (target < 0) return false;
+
+        // Các bucket đứng trước target trên dãy của key đều đầy: tăng overflow
+        b = home;
+        for (int i = 0; i < targetStep; ++i) {
+            if (buckets[b].overflow < UINT8_MAX)
+                buckets[b].overflow++;
+            b = sizing.next(b, offset);
+        }
+        Bucket& bucket = buckets[target];
+        int slot = bucket.freeSlot();
+        bucket.keys[slot] = key;
+        bucket.values[slot] = value;
+        bucket.occupied |= uint8_t(1u << slot);
+        keysPresent++;
+        stats.totalProbesInsert += probes;
+        stats.nInsert++;
+        return true;
     }
 
     bool search(const K& key, V& outValue) {
-        int base = hash(key);
-        int i = 0;
-        int probes = 0;
-        while (i < TABLE_SIZE) {
-            int probe = (base + i * i) % TABLE_SIZE;
-            probes++;
-            if (hashTable[probe].state == EMPTY)
-                break;
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                outValue = hashTable[probe].value;
-                stats.totalProbesSearch += probes;
-                stats.nSearch++;
-                return true;
+        typename Stats::OpScope scope(stats, HIST_SEARCH_MISS, stats.totalProbesSearch);
+        if (!searchHashed(key, hasher(key), outValue))
+            return false;
+        scope.markHit();
+        return true;
+    }
+
+    // Hash cả cửa sổ key và prefetch bucket gốc trước khi dò
+    void search_batch(const std::vector<K>& keys, std::vector<V>& outValues, std::vector<bool>& found) {
+        int n = static_cast<int>(keys.size());
+        outValues.resize(n);
+        found.assign(n, false);
+        uint64_t hs[BATCH_WINDOW];
+        for (int base = 0; base < n; base += BATCH_WINDOW) {
+            int cnt = std::min(BATCH_WINDOW, n - base);
+            for (int j = 0; j < cnt; ++j) {
+                hs[j] = hasher(keys[base + j]);
+                prefetchRead(&buckets[sizing.home(hs[j])]);
+            }
+            for (int j = 0; j < cnt; ++j) {
+                V v;
+                if (searchHashed(keys[base + j], hs[j], v)) {
+                    outValues[base + j] = v;
+                    found[base + j] = true;
+                }
             }
-            i++;
         }
-        stats.totalProbesSearch += probes;
-        stats.nSearch++;
-        return false;
     }
 
     void erase(const K& key) {
-        int base = hash(key);
-        int i = 0;
+        typename Stats::OpScope scope(stats, HIST_ERASE, stats.totalProbesDelete);
+        uint64_t h = hasher(key);
+        int home = sizing.home(h);
+        int offset = sizing.stride(h);
+        int b = home;
         int probes = 0;
-        while (i < TABLE_SIZE) {
-            int probe = (base + i * i) % TABLE_SIZE;
+        for (int step = 0; step < NUM_BUCKETS; ++step) {
             probes++;
-            if (hashTable[probe].state == EMPTY)
-                break;
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                hashTable[probe].state = DELETED;
+            Bucket& bucket = buckets[b];
+            int slot = bucket.find(key);
+            if (slot >= 0) {
+                bucket.occupied &= uint8_t(~(1u << slot));
                 keysPresent--;
-                stats.totalProbesDelete += probes;
-                stats.nDelete++;
-                return;
+                // Key không còn đi qua các bucket trước nó
+                int p = home;
+                for (int i = 0; i < step; ++i) {
+                    if (buckets[p].overflow < UINT8_MAX)
+                        buckets[p].overflow--;
+                    p = sizing.next(p, offset);
+                }
+                break;
             }
-            i++;
+            if (bucket.overflow == 0)
+                break;
+            b = sizing.next(b, offset);
         }
         stats.totalProbesDelete += probes;
         stats.nDelete++;
     }
 
+    double loadFactor() const {
+        return static_cast<double>(keysPresent) / size();
+    }
+
+    int size() const {
+        return NUM_BUCKETS * SLOTS;
+    }
+
+    int bucketCount() const {
+        return NUM_BUCKETS;
+    }
+
+    // Cluster tính theo dãy bucket đầy liên tiếp
     int maxClusterLength() const {
-        return ClusterUtils::maxClusterLength(hashTable);
+        return ClusterUtils::maxClusterLength(buckets);
     }
 
     double avgClusterLength() const {
-        return ClusterUtils::avgClusterLength(hashTable);
+        return ClusterUtils::avgClusterLength(buckets);
     }
 };
 
+// ======= Atomic slot cho các bảng đa luồng =======
+// state atomic (EMPTY -> BUSY -> OCCUPIED <-> DELETED), key ghi đúng một lần khi slot
+// chưa được công bố rồi không đổi nữa, value atomic để update song song với reader
+enum : uint8_t { SLOT_BUSY = DELETED + 1 };  // slot đã được giành nhưng key chưa công bố
+
 template<typename K, typename V>
-class DynamicDoubleHashTable {
-    int TABLE_SIZE;
-    int keysPresent;
-    int PRIME;
-    std::vector<Entry<K, V>> hashTable;
-    std::vector<bool> isPrimeArr;
-    const double MAX_LOAD_FACTOR = 0.7;
+struct AtomicSlot {
+    static_assert(std::is_trivially_copyable_v<V>, "value phải đọc/ghi được bằng std::atomic");
+    std::atomic<uint8_t> state{ EMPTY };
+    K key{};
+    std::atomic<V> value{};
+};
+
+// ======= Epoch-based reclamation =======
+// Reader đánh dấu epoch hiện tại trong một slot riêng khi vào vùng đọc và xoá khi ra.
+// Writer gỡ một mảng khỏi con trỏ chung, tăng epoch rồi chỉ giải phóng mảng đó khi
+// mọi reader đang hoạt động đã vào sau thời điểm gỡ.
+class EpochDomain {
+    static constexpr int MAX_READERS = 64;
+    static constexpr uint64_t IDLE = UINT64_MAX;
+
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{ IDLE };
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        std::function<void()> free;
+    };
+
+    std::atomic<uint64_t> globalEpoch{ 1 };
+    ReaderSlot readers[MAX_READERS];
+    std::vector<Retired> retired;  // chỉ writer (đang giữ khoá) chạm vào
+
+    uint64_t minActiveEpoch() const {
+        uint64_t m = IDLE;
+        for (const auto& r : readers)
+            m = std::min(m, r.epoch.load());
+        return m;
+    }
 
 public:
-    HashStats stats;
+    // Vùng đọc: giữ cho mọi mảng thấy được trong vùng này không bị giải phóng
+    class Guard {
+        EpochDomain& domain;
+        int slot;
+    public:
+        explicit Guard(EpochDomain& d) : domain(d) {
+            slot = static_cast<int>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % MAX_READERS);
+            while (true) {
+                uint64_t idle = IDLE;
+                if (domain.readers[slot].epoch.compare_exchange_weak(idle, domain.globalEpoch.load()))
+                    break;
+                slot = (slot + 1) % MAX_READERS;
+            }
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard() {
+            domain.readers[slot].epoch.store(IDLE, std::memory_order_release);
+        }
+    };
 
-    DynamicDoubleHashTable(int init_size = 101) {
-        TABLE_SIZE = helper::nextPrime(init_size);
-        keysPresent = 0;
-        hashTable.assign(TABLE_SIZE, Entry<K, V>());
-        precomputePrimes();
-        PRIME = findLargestPrimeBelow(TABLE_SIZE);
+    ~EpochDomain() {
+        for (auto& r : retired) r.free();
     }
 
-    int hash1(const K& key) const {
-        return std::hash<K>{}(key) % TABLE_SIZE;
+    // Gọi sau khi đã gỡ đối tượng khỏi mọi con trỏ chung; writer phải giữ khoá
+    void retire(std::function<void()> free) {
+        retired.push_back({ globalEpoch.fetch_add(1) + 1, std::move(free) });
+        reclaim();
     }
 
-    int hash2(const K& key) const {
-        return PRIME - (std::hash<K>{}(key) % PRIME);
+    // Giải phóng những đối tượng không còn reader nào có thể đang giữ
+    void reclaim() {
+        uint64_t safe = minActiveEpoch();
+        auto it = std::partition(retired.begin(), retired.end(), [safe](const Retired& r) { return r.epoch > safe; });
+        for (auto r = it; r != retired.end(); ++r) r->free();
+        retired.erase(it, retired.end());
     }
 
-    bool insert(const K& key, const V& value) {
-        if (loadFactor() > MAX_LOAD_FACTOR) {
-            rehash(TABLE_SIZE * 2);
-        }
+    int pending() const {
+        return static_cast<int>(retired.size());
+    }
 
-        int probe = hash1(key);
-        int offset = hash2(key);
-        int probes = 1;
-        if (hashTable[probe].state == OCCUPIED)
-            stats.totalCollision++;
+    // Chờ mọi Guard đã vào trước lời gọi này rời đi; không được gọi khi đang giữ Guard
+    void synchronize() {
+        uint64_t barrier = globalEpoch.fetch_add(1) + 1;
+        while (minActiveEpoch() < barrier)
+            std::this_thread::yield();
+    }
+};
 
-        while (hashTable[probe].state == OCCUPIED && hashTable[probe].key != key) {
-            probe = (probe + offset) % TABLE_SIZE;
-            probes++;
-        }
+// ======= Concurrent Double Hashing Table =======
+// Kích thước cố định, dùng chung dãy probe hash1/hash2 với DoubleHashTable.
+// Slot được giành bằng CAS EMPTY -> BUSY. Vì slot chỉ được giành từ EMPTY
+// và tombstone chỉ hồi sinh bởi chính key cũ, mỗi key có tối đa một slot: insert trùng
+// key đồng thời không thể tạo bản sao, reader không cần khoá.
+// Tombstone chỉ dọn được khi không còn writer nào: khi vượt MAX_TOMBSTONE_RATIO, một thread
+// chặn writer mới, chờ writer đang chạy ra (EpochDomain::synchronize), chép các key còn sống
+// sang mảng mới cùng kích thước rồi công bố như RcuDynamicDoubleHashTable; reader vẫn đọc
+// mảng cũ trong lúc đó.
+// Stats mặc định là ShardedStats: mỗi thread cộng vào dòng cache riêng, nên thống kê
+// không kéo mọi thread về cùng một dòng cache; NoStats bỏ hẳn phần đếm.
+template<typename K, typename V, typename Sizing = PrimeSizing, typename Hasher = HashUtils::MixHash<K>, typename Stats = ShardedStats>
+class ConcurrentDoubleHashTable {
+    static_assert(!Stats::HISTOGRAMS, "bảng đa luồng cần ShardedStats hoặc NoStats");
+    using Slot = AtomicSlot<K, V>;
 
-        if (hashTable[probe].state != OCCUPIED) {
-            hashTable[probe] = Entry<K, V>(key, value, OCCUPIED);
-            keysPresent++;
-            stats.totalProbesInsert += probes;
-            stats.nInsert++;
-            return true;
-        }
-        else if (hashTable[probe].key == key) {
-            hashTable[probe].value = value;
-            return true;
-        }
-        return false;
+    int TABLE_SIZE;
+    Hasher hasher;
+    Sizing sizing;
+    std::atomic<Slot*> slots;
+    std::atomic<int> keysPresent{ 0 };
+    std::atomic<int> usedSlots{ 0 };  // slot từng bị giành (OCCUPIED + DELETED) của mảng hiện tại
+    std::atomic<bool> rebuilding{ false };  // true: writer mới phải chờ
+    std::mutex rebuildLock;
+    mutable EpochDomain epochs;  // mọi thao tác đều vào Guard để rebuild biết khi nào hết writer
+
+    // Chờ thread đang ghi key công bố slot
+    static uint8_t waitPublished(const Slot& slot) {
+        uint8_t st;
+        while ((st = slot.state.load(std::memory_order_acquire)) == SLOT_BUSY)
+            std::this_thread::yield();
+        return st;
     }
 
-    bool search(const K& key, V& outValue) {
-        int probe = hash1(key);
-        int offset = hash2(key);
-        int initialPos = probe;
-        int probes = 1;
-        bool firstItr = true;
-
+    // Giữ Guard tới khi không có rebuild đang chạy; trả về mảng hiện tại.
+    // Writer kiểm tra cờ sau khi đã vào Guard nên rebuild hoặc thấy writer, hoặc writer thấy cờ
+    Slot* enterWriter(std::optional<EpochDomain::Guard>& guard) {
         while (true) {
-            if (hashTable[probe].state == EMPTY) break;
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                outValue = hashTable[probe].value;
-                stats.totalProbesSearch += probes;
-                stats.nSearch++;
-                return true;
-            }
-            if (probe == initialPos && !firstItr) break;
-            probe = (probe + offset) % TABLE_SIZE;
-            probes++;
-            firstItr = false;
+            guard.emplace(epochs);
+            if (!rebuilding.load(std::memory_order_seq_cst))
+                return slots.load(std::memory_order_seq_cst);
+            guard.reset();
+            while (rebuilding.load(std::memory_order_acquire))
+                std::this_thread::yield();
         }
-        stats.totalProbesSearch += probes;
-        stats.nSearch++;
-        return false;
     }
 
-    void erase(const K& key) {
-        int probe = hash1(key);
-        int offset = hash2(key);
-        int initialPos = probe;
-        int probes = 1;
-        bool firstItr = true;
-
-        while (true) {
-            if (hashTable[probe].state == EMPTY) {
-                stats.totalProbesDelete += probes;
-                stats.nDelete++;
-                return;
-            }
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                hashTable[probe].state = DELETED;
-                keysPresent--;
-                stats.totalProbesDelete += probes;
-                stats.nDelete++;
-                return;
+    // Trả về -1: hết slot, 0: key mới hoặc hồi sinh, 1: cập nhật key đã có
+    int insertInto(Slot* arr, const K& key, const V& value) {
+        uint64_t h = hasher(key);
+        int probe = sizing.home(h);
+        int offset = sizing.stride(h);
+        int probes = 0;
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            probes++;
+            Slot& slot = arr[probe];
+            uint8_t st = waitPublished(slot);
+            if (st == EMPTY) {
+                uint8_t expected = EMPTY;
+                if (slot.state.compare_exchange_strong(expected, SLOT_BUSY, std::memory_order_acquire)) {
+                    slot.key = key;
+                    slot.value.store(value, std::memory_order_relaxed);
+                    slot.state.store(OCCUPIED, std::memory_order_release);
+                    keysPresent.fetch_add(1, std::memory_order_relaxed);
+                    usedSlots.fetch_add(1, std::memory_order_relaxed);
+                    if (i > 0) stats.totalCollision++;
+                    stats.totalProbesInsert += probes;
+                    stats.nInsert++;
+                    return 0;
+                }
+                // Thread khác vừa giành slot này: xem lại chính slot đó
+                --i;
+                --probes;
+                continue;
             }
-            if (probe == initialPos && !firstItr) {
-                stats.totalProbesDelete += probes;
-                stats.nDelete++;
-                return;
+            if (slot.key == key) {
+                if (st == OCCUPIED) {
+                    slot.value.store(value, std::memory_order_release);
+                    return 1;
+                }
+                // Tombstone của chính key này: hồi sinh tại chỗ
+                uint8_t expected = DELETED;
+                if (slot.state.compare_exchange_strong(expected, SLOT_BUSY, std::memory_order_acquire)) {
+                    slot.value.store(value, std::memory_order_relaxed);
+                    slot.state.store(OCCUPIED, std::memory_order_release);
+                    keysPresent.fetch_add(1, std::memory_order_relaxed);
+                    if (i > 0) stats.totalCollision++;
+                    stats.totalProbesInsert += probes;
+                    stats.nInsert++;
+                    return 0;
+                }
+                --i;
+                --probes;
+                continue;
             }
-            probe = (probe + offset) % TABLE_SIZE;
-            probes++;
-            firstItr = false;
+            probe = sizing.next(probe, offset);
         }
+        return -1;
     }
 
-    double loadFactor() const {
-        return static_cast<double>(keysPresent) / TABLE_SIZE;
+    bool tooManyTombstones() const {
+        return tombstoneCount() > TombstoneUtils::MAX_TOMBSTONE_RATIO * TABLE_SIZE;
+    }
+
+public:
+    Stats stats;
+
+    // Kích thước là bậc nhỏ nhất của Sizing >= n (như RcuDynamicDoubleHashTable): dãy probe
+    // luôn đi qua mọi slot, nên compact() luôn đặt lại được mọi key
+    ConcurrentDoubleHashTable(int n) {
+        sizing.grow(n);
+        TABLE_SIZE = sizing.TABLE_SIZE;
+        slots.store(new Slot[TABLE_SIZE]);
     }
 
-    void rehash(int new_size_hint) {
-        int new_size = helper::nextPrime(new_size_hint);
-        std::vector<Entry<K, V>> oldTable = hashTable;
+    ~ConcurrentDoubleHashTable() {
+        delete[] slots.load();
+    }
 
-        TABLE_SIZE = new_size;
-        keysPresent = 0;
-        hashTable.assign(TABLE_SIZE, Entry<K, V>());
+    ConcurrentDoubleHashTable(const ConcurrentDoubleHashTable&) = delete;
+    ConcurrentDoubleHashTable& operator=(const ConcurrentDoubleHashTable&) = delete;
+
+    int hash1(const K& key) const {
+        return sizing.home(hasher(key));
+    }
+
+    int hash2(const K& key) const {
+        return sizing.stride(hasher(key));
+    }
 
-        precomputePrimes();
-        PRIME = findLargestPrimeBelow(TABLE_SIZE);
+    bool insert(const K& key, const V& value) {
+        for (int attempt = 0; ; ++attempt) {
+            int res;
+            {
+                std::optional<EpochDomain::Guard> guard;
+                res = insertInto(enterWriter(guard), key, value);
+            }
+            // Hết slot vì tombstone: dọn một lần rồi thử lại
+            if (res >= 0 || attempt > 0 || tombstoneCount() <= 0)
+                return res >= 0;
+            compact();
+        }
+    }
 
-        for (const auto& entry : oldTable) {
-            if (entry.state == OCCUPIED) {
-                insert(entry.key, entry.value);
+    bool search(const K& key, V& outValue) {
+        EpochDomain::Guard guard(epochs);
+        const Slot* arr = slots.load(std::memory_order_seq_cst);
+        uint64_t h = hasher(key);
+        int probe = sizing.home(h);
+        int offset = sizing.stride(h);
+        int probes = 0;
+        bool found = false;
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            probes++;
+            const Slot& slot = arr[probe];
+            uint8_t st = slot.state.load(std::memory_order_acquire);
+            if (st == EMPTY)
+                break;
+            // BUSY: key đang được ghi, chưa coi là đã có trong bảng
+            if (st != SLOT_BUSY && slot.key == key) {
+                if (st == OCCUPIED) {
+                    outValue = slot.value.load(std::memory_order_acquire);
+                    found = true;
+                }
+                break;  // slot duy nhất của key, DELETED nghĩa là không có
             }
+            probe = sizing.next(probe, offset);
         }
+        stats.totalProbesSearch += probes;
+        stats.nSearch++;
+        return found;
     }
 
-    void precomputePrimes() {
-        isPrimeArr.assign(TABLE_SIZE, true);
-        if (TABLE_SIZE >= 2) isPrimeArr[0] = isPrimeArr[1] = false;
-        for (int i = 2; i * i < TABLE_SIZE; ++i) {
-            if (isPrimeArr[i]) {
-                for (int j = i * i; j < TABLE_SIZE; j += i) {
-                    isPrimeArr[j] = false;
+    void erase(const K& key) {
+        {
+            std::optional<EpochDomain::Guard> guard;
+            Slot* arr = enterWriter(guard);
+            uint64_t h = hasher(key);
+            int probe = sizing.home(h);
+            int offset = sizing.stride(h);
+            int probes = 0;
+            for (int i = 0; i < TABLE_SIZE; ++i) {
+                probes++;
+                Slot& slot = arr[probe];
+                uint8_t st = waitPublished(slot);
+                if (st == EMPTY)
+                    break;
+                if (slot.key == key) {
+                    uint8_t expected = OCCUPIED;
+                    if (slot.state.compare_exchange_strong(expected, DELETED, std::memory_order_acq_rel))
+                        keysPresent.fetch_sub(1, std::memory_order_relaxed);
+                    break;
                 }
+                probe = sizing.next(probe, offset);
             }
+            stats.totalProbesDelete += probes;
+            stats.nDelete++;
         }
+        // Ra khỏi Guard trước: compact chờ mọi Guard của writer kết thúc
+        if (tooManyTombstones())
+            compact();
     }
 
-    int findLargestPrimeBelow(int n) {
-        for (int i = n - 1; i >= 2; --i) {
-            if (isPrimeArr[i]) return i;
+    // Dọn toàn bộ tombstone: chặn writer, chờ writer đang chạy xong, chép key còn sống sang
+    // mảng mới cùng kích thước. Không được gọi khi đang giữ Guard của bảng này
+    void compact() {
+        std::unique_lock<std::mutex> lock(rebuildLock, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            // Thread khác đang dọn: chờ xong là đủ
+            std::lock_guard<std::mutex> wait(rebuildLock);
+            return;
+        }
+        if (tombstoneCount() <= 0)
+            return;
+        rebuilding.store(true, std::memory_order_seq_cst);
+        epochs.synchronize();
+
+        Slot* old = slots.load(std::memory_order_relaxed);
+        Slot* fresh = new Slot[TABLE_SIZE];
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            const Slot& slot = old[i];
+            if (slot.state.load(std::memory_order_relaxed) != OCCUPIED) continue;
+            uint64_t h = hasher(slot.key);
+            int probe = sizing.home(h);
+            int offset = sizing.stride(h);
+            int step = 0;
+            for (; step < TABLE_SIZE && fresh[probe].state.load(std::memory_order_relaxed) != EMPTY; ++step)
+                probe = sizing.next(probe, offset);
+            if (step == TABLE_SIZE) {
+                // Dãy probe không phủ hết bảng (Sizing không đảm bảo): giữ nguyên mảng cũ
+                delete[] fresh;
+                rebuilding.store(false, std::memory_order_release);
+                return;
+            }
+            fresh[probe].key = slot.key;
+            fresh[probe].value.store(slot.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            fresh[probe].state.store(OCCUPIED, std::memory_order_relaxed);
         }
-        return 2;
+        usedSlots.store(keysPresent.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        slots.store(fresh, std::memory_order_seq_cst);
+        epochs.retire([old] { delete[] old; });
+        stats.nCompact++;
+        rebuilding.store(false, std::memory_order_release);
     }
 
-    int maxClusterLength() const {
-        return ClusterUtils::maxClusterLength(hashTable);
+    double loadFactor() const {
+        return static_cast<double>(keysPresent.load(std::memory_order_relaxed)) / TABLE_SIZE;
     }
 
-    double avgClusterLength() const {
-        return ClusterUtils::avgClusterLength(hashTable);
+    double usedLoadFactor() const {
+        return static_cast<double>(usedSlots.load(std::memory_order_relaxed)) / TABLE_SIZE;
+    }
+
+    int tombstoneCount() const {
+        return usedSlots.load(std::memory_order_relaxed) - keysPresent.load(std::memory_order_relaxed);
     }
 
     int size() const {
@@ -618,252 +3148,439 @@ public:
     }
 };
 
-template<typename K, typename V>
-class DynamicLinearHashTable {
-    int TABLE_SIZE;
-    int keysPresent;
-    std::vector<Entry<K, V>> hashTable;
-
-    void rehash() {
-        int newSize = helper::nextPrime(TABLE_SIZE * 2);
-        std::vector<Entry<K, V>> oldTable = hashTable;
-        TABLE_SIZE = newSize;
-        keysPresent = 0;
-        hashTable.assign(TABLE_SIZE, Entry<K, V>());
+// ======= RCU Dynamic Double Hashing Table =======
+// Chế độ đọc nhiều: writer tuần tự qua một mutex, reader không khoá. Khi cần rehash,
+// mảng mới được dựng bên cạnh trong lúc reader vẫn đọc mảng cũ, rồi công bố bằng
+// một lần store con trỏ; mảng cũ được EpochDomain giải phóng khi không còn ai đọc.
+// Stats như ConcurrentDoubleHashTable: ShardedStats để reader không ghi vào dòng cache chung.
+template<typename K, typename V, typename Sizing = PrimeSizing, typename Hasher = HashUtils::MixHash<K>, typename Stats = ShardedStats>
+class RcuDynamicDoubleHashTable {
+    static_assert(!Stats::HISTOGRAMS, "bảng đa luồng cần ShardedStats hoặc NoStats");
+    using Slot = AtomicSlot<K, V>;
+
+    struct Array {
+        Sizing sizing;
+        int TABLE_SIZE;
+        std::unique_ptr<Slot[]> slots;
+
+        explicit Array(long long size_hint) {
+            sizing.grow(size_hint);
+            TABLE_SIZE = sizing.TABLE_SIZE;
+            slots = std::make_unique<Slot[]>(TABLE_SIZE);
+        }
+    };
+
+    static constexpr double MAX_LOAD_FACTOR = 0.7;
+    Hasher hasher;
+    std::atomic<Array*> current;
+    std::mutex writeLock;
+    mutable EpochDomain epochs;  // size()/loadFactor() const cũng phải vào vùng đọc
+    std::atomic<int> keysPresent{ 0 };
+    int usedSlots = 0;  // OCCUPIED + DELETED của mảng hiện tại, chỉ writer đọc/ghi
+
+    // Writer duy nhất nên không cần BUSY: ghi key/value trước, công bố state sau.
+    // Tombstone chỉ hồi sinh bởi chính key cũ vì reader có thể đang đọc key của slot.
+    static void place(Array& arr, const K& key, const V& value, int probe) {
+        Slot& slot = arr.slots[probe];
+        slot.key = key;
+        slot.value.store(value, std::memory_order_relaxed);
+        slot.state.store(OCCUPIED, std::memory_order_release);
+    }
 
-        for (const auto& entry : oldTable) {
-            if (entry.state == OCCUPIED) {
-                insert(entry.key, entry.value);
-            }
+    void rebuild(long long size_hint) {
+        Array* old = current.load(std::memory_order_relaxed);
+        Array* fresh = new Array(size_hint);
+        for (int i = 0; i < old->TABLE_SIZE; ++i) {
+            const Slot& slot = old->slots[i];
+            if (slot.state.load(std::memory_order_relaxed) != OCCUPIED) continue;
+            uint64_t h = hasher(slot.key);
+            int probe = fresh->sizing.home(h);
+            int offset = fresh->sizing.stride(h);
+            while (fresh->slots[probe].state.load(std::memory_order_relaxed) != EMPTY)
+                probe = fresh->sizing.next(probe, offset);
+            place(*fresh, slot.key, slot.value.load(std::memory_order_relaxed), probe);
         }
+        usedSlots = keysPresent.load(std::memory_order_relaxed);
+        current.store(fresh, std::memory_order_seq_cst);
+        epochs.retire([old] { delete old; });
+        stats.nResize++;
     }
 
 public:
-    HashStats stats;
+    Stats stats;
 
-    DynamicLinearHashTable(int initialSize = 17) {
-        TABLE_SIZE = helper::nextPrime(initialSize);
-        keysPresent = 0;
-        hashTable.assign(TABLE_SIZE, Entry<K, V>());
-    }
+    RcuDynamicDoubleHashTable(int init_size = 101) : current(new Array(init_size)) {}
 
-    double loadFactor() const {
-        return 1.0 * keysPresent / TABLE_SIZE;
+    ~RcuDynamicDoubleHashTable() {
+        delete current.load();
     }
 
-    int hash(const K& key) const {
-        return std::hash<K>{}(key) % TABLE_SIZE;
-    }
+    RcuDynamicDoubleHashTable(const RcuDynamicDoubleHashTable&) = delete;
+    RcuDynamicDoubleHashTable& operator=(const RcuDynamicDoubleHashTable&) = delete;
 
     bool insert(const K& key, const V& value) {
-        if (loadFactor() > 0.7)
-            rehash();
-
-        int probe = hash(key);
-        int probes = 1;
-
-        if (hashTable[probe].state == OCCUPIED)
-            stats.totalCollision++;
-
-        while (hashTable[probe].state == OCCUPIED && hashTable[probe].key != key) {
-            probe = (probe + 1) % TABLE_SIZE;
-            probes++;
+        std::lock_guard<std::mutex> lock(writeLock);
+        Array* arr = current.load(std::memory_order_relaxed);
+        if (usedSlots + 1 > MAX_LOAD_FACTOR * arr->TABLE_SIZE) {
+            // Đa số slot đã dùng là tombstone: dựng lại cùng kích thước thay vì nhân đôi
+            // Ở kích thước lớn nhất thì dùng nốt slot còn lại thay vì dựng lại cùng cỡ mỗi lần insert
+            bool mostlyTombstones = keysPresent.load(std::memory_order_relaxed) <= MAX_LOAD_FACTOR / 2 * arr->TABLE_SIZE;
+            if (mostlyTombstones || arr->TABLE_SIZE < Sizing::MAX_TABLE_SIZE) {
+                rebuild(mostlyTombstones ? arr->TABLE_SIZE : 2LL * arr->TABLE_SIZE);
+                arr = current.load(std::memory_order_relaxed);
+            }
         }
 
-        if (hashTable[probe].state != OCCUPIED) {
-            hashTable[probe] = Entry<K, V>(key, value, OCCUPIED);
-            keysPresent++;
-            stats.totalProbesInsert += probes;
-            stats.nInsert++;
-            return true;
-        }
-        else if (hashTable[probe].key == key) {
-            hashTable[probe].value = value;
-            return true;
+        uint64_t h = hasher(key);
+        int probe = arr->sizing.home(h);
+        int offset = arr->sizing.stride(h);
+        int probes = 0;
+        bool placed = false;
+        for (int i = 0; i < arr->TABLE_SIZE; ++i) {
+            probes++;
+            Slot& slot = arr->slots[probe];
+            uint8_t st = slot.state.load(std::memory_order_relaxed);
+            if (st == EMPTY) {
+                place(*arr, key, value, probe);
+                usedSlots++;
+                keysPresent.fetch_add(1, std::memory_order_relaxed);
+                placed = true;
+                break;
+            }
+            if (slot.key == key) {
+                slot.value.store(value, std::memory_order_release);
+                if (st == DELETED) {
+                    slot.state.store(OCCUPIED, std::memory_order_release);
+                    keysPresent.fetch_add(1, std::memory_order_relaxed);
+                    placed = true;
+                    break;
+                }
+                return true;
+            }
+            probe = arr->sizing.next(probe, offset);
         }
-
-        return false;
+        if (!placed) return false;
+        if (probes > 1) stats.totalCollision++;
+        stats.totalProbesInsert += probes;
+        stats.nInsert++;
+        return true;
     }
 
     bool search(const K& key, V& outValue) {
-        int probe = hash(key);
-        int probes = 1;
-
-        while (hashTable[probe].state != EMPTY) {
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                outValue = hashTable[probe].value;
-                stats.totalProbesSearch += probes;
-                stats.nSearch++;
-                return true;
-            }
-            probe = (probe + 1) % TABLE_SIZE;
+        EpochDomain::Guard guard(epochs);
+        const Array* arr = current.load(std::memory_order_seq_cst);
+        uint64_t h = hasher(key);
+        int probe = arr->sizing.home(h);
+        int offset = arr->sizing.stride(h);
+        int probes = 0;
+        bool found = false;
+        for (int i = 0; i < arr->TABLE_SIZE; ++i) {
             probes++;
+            const Slot& slot = arr->slots[probe];
+            uint8_t st = slot.state.load(std::memory_order_acquire);
+            if (st == EMPTY)
+                break;
+            if (slot.key == key) {
+                if (st == OCCUPIED) {
+                    outValue = slot.value.load(std::memory_order_acquire);
+                    found = true;
+                }
+                break;  // slot duy nhất của key, DELETED nghĩa là không có
+            }
+            probe = arr->sizing.next(probe, offset);
         }
-
         stats.totalProbesSearch += probes;
         stats.nSearch++;
-        return false;
+        return found;
     }
 
     void erase(const K& key) {
-        int probe = hash(key);
-        int probes = 1;
-
-        while (hashTable[probe].state != EMPTY) {
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                hashTable[probe].state = DELETED;
-                keysPresent--;
-                stats.totalProbesDelete += probes;
-                stats.nDelete++;
-                return;
-            }
-            probe = (probe + 1) % TABLE_SIZE;
+        std::lock_guard<std::mutex> lock(writeLock);
+        Array* arr = current.load(std::memory_order_relaxed);
+        uint64_t h = hasher(key);
+        int probe = arr->sizing.home(h);
+        int offset = arr->sizing.stride(h);
+        int probes = 0;
+        for (int i = 0; i < arr->TABLE_SIZE; ++i) {
             probes++;
+            Slot& slot = arr->slots[probe];
+            uint8_t st = slot.state.load(std::memory_order_relaxed);
+            if (st == EMPTY)
+                break;
+            if (slot.key == key) {
+                if (st == OCCUPIED) {
+                    slot.state.store(DELETED, std::memory_order_release);
+                    keysPresent.fetch_sub(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+            probe = arr->sizing.next(probe, offset);
         }
-
         stats.totalProbesDelete += probes;
         stats.nDelete++;
     }
 
-    int maxClusterLength() const {
-        return ClusterUtils::maxClusterLength(hashTable);
+    double loadFactor() const {
+        EpochDomain::Guard guard(epochs);
+        const Array* arr = current.load(std::memory_order_seq_cst);
+        return static_cast<double>(keysPresent.load(std::memory_order_relaxed)) / arr->TABLE_SIZE;
     }
 
-    double avgClusterLength() const {
-        return ClusterUtils::avgClusterLength(hashTable);
+    // Kích thước của mảng đang được công bố; đọc trong Guard vì writer có thể giải phóng mảng
+    int size() const {
+        EpochDomain::Guard guard(epochs);
+        return current.load(std::memory_order_seq_cst)->TABLE_SIZE;
     }
 
-    int size() const {
-        return TABLE_SIZE;
+    // Số mảng cũ đang chờ reader rời đi để giải phóng
+    int pendingReclaim() {
+        std::lock_guard<std::mutex> lock(writeLock);
+        epochs.reclaim();
+        return epochs.pending();
     }
 };
 
-template<typename K, typename V>
-class DynamicQuadraticHashTable {
-    int TABLE_SIZE;
-    int keysPresent;
-    std::vector<Entry<K, V>> hashTable;
-
-    void rehash() {
-        int newSize = helper::nextPrime(TABLE_SIZE * 2);
-        std::vector<Entry<K, V>> oldTable = hashTable;
-        TABLE_SIZE = newSize;
-        keysPresent = 0;
-        hashTable.assign(TABLE_SIZE, Entry<K, V>());
+// ======= Thread pool =======
+// Số worker cố định, hàng đợi task dùng chung; parallelFor cho caller cùng làm việc
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable ready;
+    bool stopping = false;
 
-        for (const auto& entry : oldTable) {
-            if (entry.state == OCCUPIED) {
-                insert(entry.key, entry.value);
+    void workerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
             }
+            task();
         }
     }
 
 public:
-    HashStats stats;
+    // threads = tổng số thread tham gia parallelFor, kể cả thread gọi
+    explicit ThreadPool(int threads = static_cast<int>(std::thread::hardware_concurrency())) {
+        for (int i = 1; i < threads; ++i)
+            workers.emplace_back([this] { workerLoop(); });
+    }
 
-    DynamicQuadraticHashTable(int initialSize = 17) {
-        TABLE_SIZE = helper::nextPrime(initialSize);
-        keysPresent = 0;
-        hashTable.assign(TABLE_SIZE, Entry<K, V>());
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& w : workers) w.join();
     }
 
-    double loadFactor() const {
-        return 1.0 * keysPresent / TABLE_SIZE;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int threadCount() const {
+        return static_cast<int>(workers.size()) + 1;
     }
 
-    int hash(const K& key) const {
-        return std::hash<K>{}(key) % TABLE_SIZE;
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push_back(std::move(task));
+        }
+        ready.notify_one();
     }
 
-    bool insert(const K& key, const V& value) {
-        if (loadFactor() > 0.7)
-            rehash();
+    // Chạy fn(i) với mọi i trong [0, n), chia động qua một bộ đếm chung, chờ tới khi xong
+    template<typename Fn>
+    void parallelFor(int n, Fn fn) {
+        std::atomic<int> next{ 0 };
+        auto drain = [&] {
+            for (int i = next++; i < n; i = next++)
+                fn(i);
+        };
+        int helpers = std::min(static_cast<int>(workers.size()), n - 1);
+        if (helpers <= 0) {
+            drain();
+            return;
+        }
+        std::latch done(helpers);
+        for (int h = 0; h < helpers; ++h) {
+            submit([&] {
+                drain();
+                done.count_down();
+            });
+        }
+        drain();
+        done.wait();
+    }
+};
 
-        int base = hash(key);
-        int i = 0;
-        int probes = 0;
+// ======= Sharded Double Hashing Table =======
+// Key được chia vào NUM_SHARDS (luỹ thừa của 2) DynamicDoubleHashTable độc lập, mỗi shard
+// một mutex và lịch rehash riêng: writer ở các shard khác nhau không chặn nhau, và một lần
+// rehash chỉ dừng 1/NUM_SHARDS dữ liệu. Các API *_bulk gom key theo shard rồi xử lý song song.
+template<typename K, typename V, typename Hasher = HashUtils::MixHash<K>>
+class ShardedHashTable {
+    using Table = DynamicDoubleHashTable<K, V, AoSSlots, PrimeSizing, Hasher>;
+
+    struct alignas(64) Shard {
+        std::mutex lock;
+        Table table;
+        explicit Shard(int init_size) : table(init_size) {}
+    };
+
+    int NUM_SHARDS;
+    int SHARD_BITS;
+    Hasher hasher;
+    std::vector<std::unique_ptr<Shard>> shards;
+    ThreadPool pool;
+
+    // Bit cao sau phép nhân Fibonacci: hi32 của hash còn được sizing dùng làm bước nhảy,
+    // lấy thẳng bit cao sẽ làm mọi key trong một shard có bước nhảy gần giống nhau
+    int shardOf(const K& key) const {
+        if (SHARD_BITS == 0) return 0;
+        return static_cast<int>((hasher(key) * 0x9E3779B97F4A7C15ull) >> (64 - SHARD_BITS));
+    }
 
-        while (i < TABLE_SIZE) {
-            int probe = (base + i * i) % TABLE_SIZE;
-            probes++;
-            if (i == 0 && hashTable[probe].state == OCCUPIED)
-                stats.totalCollision++;
-
-            if (hashTable[probe].state == EMPTY || hashTable[probe].state == DELETED) {
-                hashTable[probe] = Entry<K, V>(key, value, OCCUPIED);
-                keysPresent++;
-                stats.totalProbesInsert += probes;
-                stats.nInsert++;
-                return true;
-            }
-            else if (hashTable[probe].key == key) {
-                hashTable[probe].value = value;
-                return true;
-            }
-            i++;
-        }
+    // Gom chỉ số key theo shard để mỗi shard chỉ bị khoá một lần cho cả lô
+    std::vector<std::vector<int>> groupByShard(const std::vector<K>& keys) const {
+        std::vector<std::vector<int>> buckets(NUM_SHARDS);
+        for (int i = 0; i < static_cast<int>(keys.size()); ++i)
+            buckets[shardOf(keys[i])].push_back(i);
+        return buckets;
+    }
 
-        return false;
+public:
+    ShardedHashTable(int numShards = 16, int init_size = 101, int threads = static_cast<int>(std::thread::hardware_concurrency()))
+        : pool(std::max(1, threads)) {
+        NUM_SHARDS = static_cast<int>(std::bit_ceil(static_cast<unsigned>(std::max(1, numShards))));
+        SHARD_BITS = std::countr_zero(static_cast<unsigned>(NUM_SHARDS));
+        int perShard = std::max(1, init_size / NUM_SHARDS);
+        for (int i = 0; i < NUM_SHARDS; ++i)
+            shards.push_back(std::make_unique<Shard>(perShard));
+    }
+
+    bool insert(const K& key, const V& value) {
+        Shard& shard = *shards[shardOf(key)];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        return shard.table.insert(key, value);
     }
 
     bool search(const K& key, V& outValue) {
-        int base = hash(key);
-        int i = 0;
-        int probes = 0;
+        Shard& shard = *shards[shardOf(key)];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        return shard.table.search(key, outValue);
+    }
 
-        while (i < TABLE_SIZE) {
-            int probe = (base + i * i) % TABLE_SIZE;
-            probes++;
-            if (hashTable[probe].state == EMPTY)
-                break;
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                outValue = hashTable[probe].value;
-                stats.totalProbesSearch += probes;
-                stats.nSearch++;
-                return true;
-            }
-            i++;
-        }
+    void erase(const K& key) {
+        Shard& shard = *shards[shardOf(key)];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.table.erase(key);
+    }
 
-        stats.totalProbesSearch += probes;
-        stats.nSearch++;
-        return false;
+    // Trả về số cặp chèn hoặc cập nhật thành công
+    int insert_bulk(const std::vector<K>& keys, const std::vector<V>& values) {
+        auto buckets = groupByShard(keys);
+        std::atomic<int> ok{ 0 };
+        pool.parallelFor(NUM_SHARDS, [&](int s) {
+            Shard& shard = *shards[s];
+            std::lock_guard<std::mutex> guard(shard.lock);
+            int local = 0;
+            for (int i : buckets[s])
+                local += shard.table.insert(keys[i], values[i]);
+            ok += local;
+        });
+        return ok.load();
     }
 
-    void erase(const K& key) {
-        int base = hash(key);
-        int i = 0;
-        int probes = 0;
+    void search_bulk(const std::vector<K>& keys, std::vector<V>& outValues, std::vector<bool>& found) {
+        int n = static_cast<int>(keys.size());
+        outValues.resize(n);
+        // vector<bool> đóng gói bit, ghi song song từ nhiều thread sẽ tranh nhau cùng một byte
+        std::vector<uint8_t> hit(n, 0);
+        auto buckets = groupByShard(keys);
+        pool.parallelFor(NUM_SHARDS, [&](int s) {
+            Shard& shard = *shards[s];
+            std::lock_guard<std::mutex> guard(shard.lock);
+            for (int i : buckets[s])
+                hit[i] = shard.table.search(keys[i], outValues[i]);
+        });
+        found.assign(hit.begin(), hit.end());
+    }
 
-        while (i < TABLE_SIZE) {
-            int probe = (base + i * i) % TABLE_SIZE;
-            probes++;
-            if (hashTable[probe].state == EMPTY)
-                break;
-            if (hashTable[probe].state == OCCUPIED && hashTable[probe].key == key) {
-                hashTable[probe].state = DELETED;
-                keysPresent--;
-                stats.totalProbesDelete += probes;
-                stats.nDelete++;
-                return;
+    void erase_bulk(const std::vector<K>& keys) {
+        auto buckets = groupByShard(keys);
+        pool.parallelFor(NUM_SHARDS, [&](int s) {
+            Shard& shard = *shards[s];
+            std::lock_guard<std::mutex> guard(shard.lock);
+            for (int i : buckets[s])
+                shard.table.erase(keys[i]);
+        });
+    }
+
+    // Cộng dồn thống kê của mọi shard
+    HashStats aggregateStats() {
+        HashStats total;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> guard(shard->lock);
+            const HashStats& st = shard->table.stats;
+            total.totalProbesInsert += st.totalProbesInsert;
+            total.totalProbesSearch += st.totalProbesSearch;
+            total.totalProbesDelete += st.totalProbesDelete;
+            total.totalCollision += st.totalCollision;
+            total.nInsert += st.nInsert;
+            total.nSearch += st.nSearch;
+            total.nDelete += st.nDelete;
+            total.nCompact += st.nCompact;
+            total.nResize += st.nResize;
+            if (st.hist) {
+                total.enableHistograms();
+                total.hist->merge(*st.hist);
             }
-            i++;
         }
+        return total;
+    }
+
+    // Bật histogram độ trễ/probe trên mọi shard, gộp lại qua aggregateStats()
+    void enableHistograms() {
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> guard(shard->lock);
+            shard->table.stats.enableHistograms();
+        }
+    }
 
-        stats.totalProbesDelete += probes;
-        stats.nDelete++;
+    // Tổng số slot của mọi shard
+    int size() {
+        int total = 0;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> guard(shard->lock);
+            total += shard->table.size();
+        }
+        return total;
     }
 
-    int maxClusterLength() const {
-        return ClusterUtils::maxClusterLength(hashTable);
+    double loadFactor() {
+        double keys = 0;
+        int slots = 0;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> guard(shard->lock);
+            keys += shard->table.loadFactor() * shard->table.size();
+            slots += shard->table.size();
+        }
+        return slots ? keys / slots : 0;
     }
 
-    double avgClusterLength() const {
-        return ClusterUtils::avgClusterLength(hashTable);
+    int shardCount() const {
+        return NUM_SHARDS;
     }
 
-    int size() const {
-        return TABLE_SIZE;
+    int shardSize(int s) {
+        std::lock_guard<std::mutex> guard(shards[s]->lock);
+        return shards[s]->table.size();
     }
 };
 
@@ -897,8 +3614,25 @@ namespace BenchmarkUtils {
     }
 
     namespace generator {
+        // Mọi bộ sinh ngẫu nhiên lấy seed từ đây: cùng seed và cùng thứ tự gọi cho ra
+        // đúng cùng dữ liệu, nên hai lần chạy (hoặc hai bản build) so sánh được với nhau
+        constexpr uint64_t DEFAULT_SEED = 42;
+        inline uint64_t seed = DEFAULT_SEED;
+        inline uint32_t stream = 0;
+
+        void setSeed(uint64_t s) {
+            seed = s;
+            stream = 0;
+        }
+
+        // Mỗi lần gọi trả về một engine mới, tách từ seed chung theo số thứ tự lần gọi
+        std::mt19937 makeRng() {
+            std::seed_seq seq{ helper::lo32(seed), helper::hi32(seed), stream++ };
+            return std::mt19937(seq);
+        }
+
         std::vector<std::pair<int, int>> generateRandomKeyVals(int M, int key_upper, int val_upper = 1000000) {
-            std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
+            std::mt19937 rng = makeRng();
             std::uniform_int_distribution<int> dist_key(1, key_upper);
             std::uniform_int_distribution<int> dist_val(1, val_upper);
 
@@ -914,7 +3648,7 @@ namespace BenchmarkUtils {
         }
 
         std::vector<std::pair<int, int>> generateSequentialKeyVals(int M, int val_upper = 1000000) {
-            std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
+            std::mt19937 rng = makeRng();
             std::uniform_int_distribution<int> dist_val(1, val_upper);
             std::vector<std::pair<int, int>> keyvals;
             for (int i = 1; i <= M; ++i)
@@ -923,7 +3657,7 @@ namespace BenchmarkUtils {
         }
 
         std::vector<std::pair<int, int>> generateClusteredKeyVals(int M, int key_upper, int val_upper = 1000000) {
-            std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
+            std::mt19937 rng = makeRng();
             std::uniform_int_distribution<int> dist_val(1, val_upper);
 
             int num_clusters = 5;
@@ -946,7 +3680,7 @@ namespace BenchmarkUtils {
         std::vector<int> generateMissKeys(int num_miss, const std::unordered_set<int>& exist_keys, int key_upper_bound) {
             std::unordered_set<int> used = exist_keys; // copy để không làm thay đổi input gốc
             std::vector<int> miss_keys;
-            std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
+            std::mt19937 rng = makeRng();
             std::uniform_int_distribution<int> dist_key(1, key_upper_bound);
 
             while ((int)miss_keys.size() < num_miss) {
@@ -960,112 +3694,507 @@ namespace BenchmarkUtils {
         }
     }
 
-    template<typename DHTable, typename LTable, typename QTable>
-    void insertAndPrintClusterStats(const DHTable& dht, const LTable& lpt, const QTable& qpt, const std::vector<std::pair<int, int>>& keyvals, const std::string& label = "") {
+    // Dữ liệu cho một lần đo testTable trên một kiểu phân bố key
+    struct Workload {
+        std::string patternName;
+        std::vector<std::pair<int, int>> keyvals;
+        std::vector<int> search_hit_indices;
+        std::vector<int> search_miss_keys;
+        std::vector<int> delete_indices;
+    };
+
+    const char* const PATTERN_NAMES[] = { "RANDOM", "SEQUENTIAL", "CLUSTERED" };
+
+    // pattern: 1 = RANDOM, 2 = SEQUENTIAL, 3 = CLUSTERED; key_upper là cận trên của key random/miss
+    Workload makeWorkload(int pattern, int M, double miss_rate, int key_upper) {
+        Workload w;
+        w.patternName = PATTERN_NAMES[pattern - 1];
+
+        // Tạo key-value tương ứng
+        if (pattern == 1)
+            w.keyvals = generator::generateRandomKeyVals(M, key_upper);
+        else if (pattern == 2)
+            w.keyvals = generator::generateSequentialKeyVals(M);
+        else
+            w.keyvals = generator::generateClusteredKeyVals(M, key_upper);
+
+        // Sinh chỉ số search hit/miss
+        std::vector<int> all_indices(M);
+        helper::iota(all_indices.begin(), all_indices.end(), 0);
+
+        int num_search = M;
+        int num_miss = int(num_search * miss_rate + 0.5);
+        int num_hit = num_search - num_miss;
+
+        // Hit indices
+        std::vector<int> indices = all_indices;
+        std::shuffle(indices.begin(), indices.end(), generator::makeRng());
+        w.search_hit_indices.assign(indices.begin(), indices.begin() + num_hit);
+
+        // Miss keys
+        std::unordered_set<int> exist_keys;
+        for (const auto& kv : w.keyvals) exist_keys.insert(kv.first);
+        w.search_miss_keys = generator::generateMissKeys(num_miss, exist_keys, key_upper);
+
+        // Delete indices (xoá toàn bộ key theo thứ tự ngẫu nhiên)
+        w.delete_indices = all_indices;
+        std::shuffle(w.delete_indices.begin(), w.delete_indices.end(), generator::makeRng());
+        return w;
+    }
+
+    template<typename DHTable, typename LTable, typename QTable, typename HTable>
+    void insertAndPrintClusterStats(const DHTable& dht, const LTable& lpt, const QTable& qpt, const HTable& hst, const std::vector<std::pair<int, int>>& keyvals, const std::string& label = "") {
         DHTable dht_copy = dht;
         LTable lpt_copy = lpt;
         QTable qpt_copy = qpt;
+        HTable hst_copy = hst;
         for (auto& kv : keyvals) {
             dht_copy.insert(kv.first, kv.second);
             lpt_copy.insert(kv.first, kv.second);
             qpt_copy.insert(kv.first, kv.second);
+            hst_copy.insert(kv.first, kv.second);
         }
         std::cout << "\n===== CLUSTER LENGTH STATISTICS" << (label.empty() ? "" : (" - " + label)) << " =====\n";
         std::cout << std::setw(32) << std::left << " "
             << std::setw(20) << "Double Hashing"
             << std::setw(20) << "Linear Probing"
-            << std::setw(20) << "Quadratic Probing" << '\n';
+            << std::setw(20) << "Quadratic Probing"
+            << std::setw(20) << "Hopscotch" << '\n';
         std::cout << std::setw(32) << std::left << "[Max cluster length]:"
             << std::setw(20) << dht_copy.maxClusterLength()
             << std::setw(20) << lpt_copy.maxClusterLength()
-            << std::setw(20) << qpt_copy.maxClusterLength() << '\n';
+            << std::setw(20) << qpt_copy.maxClusterLength()
+            << std::setw(20) << hst_copy.maxClusterLength() << '\n';
         std::cout << std::setw(32) << std::left << "[Avg cluster length]:"
             << std::setw(20) << dht_copy.avgClusterLength()
             << std::setw(20) << lpt_copy.avgClusterLength()
-            << std::setw(20) << qpt_copy.avgClusterLength() << '\n';
+            << std::setw(20) << qpt_copy.avgClusterLength()
+            << std::setw(20) << hst_copy.avgClusterLength() << '\n';
+    }
+
+    // ======= Đo thời gian =======
+    // Chạy warmup, lặp lại đến khi khoảng tin cậy 95% đủ hẹp (hoặc chạm maxReps),
+    // báo median/min/stddev thay vì trung bình vài lần chạy
+    namespace measure {
+        struct Config {
+            int warmup = 1;
+            int minReps = 5;
+            int maxReps = 30;
+            double targetRelCI = 0.02;  // dừng khi ci95 / mean <= 2% ở mọi pha
+        };
+
+        inline Config config;
+
+        // Phân vị 97.5% của phân phối Student t theo bậc tự do, xấp xỉ 1.96 khi df lớn
+        double tQuantile(int df) {
+            static const double T[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+            if (df < 1) return 0;
+            return df <= 30 ? T[df - 1] : 1.96;
+        }
+
+        PhaseStats summarize(std::vector<double> samples, long long ops) {
+            PhaseStats ps;
+            ps.samples = samples.size();
+            ps.ops = ops;
+            if (samples.empty()) return ps;
+
+            std::sort(samples.begin(), samples.end());
+            int n = samples.size();
+            ps.minNs = samples.front();
+            ps.medianNs = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+            double sum = 0;
+            for (double x : samples) sum += x;
+            ps.meanNs = sum / n;
+            double sq = 0;
+            for (double x : samples) sq += (x - ps.meanNs) * (x - ps.meanNs);
+            ps.stddevNs = n > 1 ? std::sqrt(sq / (n - 1)) : 0;
+            ps.ci95Ns = n > 1 ? tQuantile(n - 1) * ps.stddevNs / std::sqrt(double(n)) : 0;
+            ps.nsPerOp = ops > 0 ? ps.medianNs / ops : 0;
+            return ps;
+        }
+
+        bool converged(const std::vector<double>& samples, const Config& cfg) {
+            return (int)samples.size() >= cfg.minReps && summarize(samples, 1).relCI() <= cfg.targetRelCI;
+        }
+
+        template <typename Fn>
+        double elapsedNs(Fn&& fn) {
+            auto t1 = std::chrono::steady_clock::now();
+            fn();
+            auto t2 = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::nano>(t2 - t1).count();
+        }
+
+        // Ghim thread hiện tại vào một core để bỏ nhiễu do migrate giữa các core.
+        // cpu < 0: lấy core đầu tiên trong affinity mask hiện có. Trả về false nếu không ghim được
+        bool pinToCore(int cpu = -1) {
+#if defined(__linux__)
+            cpu_set_t set;
+            if (cpu < 0) {
+                if (sched_getaffinity(0, sizeof(set), &set) != 0) return false;
+                for (int c = 0; c < CPU_SETSIZE && cpu < 0; ++c)
+                    if (CPU_ISSET(c, &set)) cpu = c;
+                if (cpu < 0) return false;
+            }
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+            (void)cpu;
+            return false;
+#endif
+        }
+
+        // Đo một thao tác không trạng thái: warmup rồi lặp đến khi hội tụ
+        template <typename Fn>
+        PhaseStats run(long long ops, Fn&& fn, const Config& cfg = config) {
+            for (int i = 0; i < cfg.warmup; ++i) fn();
+            std::vector<double> samples;
+            while ((int)samples.size() < cfg.maxReps) {
+                samples.push_back(elapsedNs(fn));
+                if (converged(samples, cfg)) break;
+            }
+            return summarize(samples, ops);
+        }
+    }
+
+    // ======= Bộ đếm phần cứng =======
+    // perf_event_open trên Linux, chỉ đếm user space của chính tiến trình. Event nào không mở
+    // được (không có quyền, máy ảo không hỗ trợ PMU...) thì bị bỏ qua và báo -1
+    namespace perf {
+        class CounterSet {
+            int fds[PERF_EVENT_COUNT];
+            std::string error;
+
+#if defined(__linux__)
+            static int open(uint32_t type, uint64_t config) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = type;
+                attr.config = config;
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+
+            static uint64_t cacheMiss(uint64_t cache) {
+                return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            }
+#endif
+
+        public:
+            CounterSet() {
+                std::fill(std::begin(fds), std::end(fds), -1);
+#if defined(__linux__)
+                fds[PERF_CYCLES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+                fds[PERF_INSTRUCTIONS] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+                fds[PERF_L1D_MISSES] = open(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D));
+                fds[PERF_LLC_MISSES] = open(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL));
+                if (fds[PERF_LLC_MISSES] < 0)
+                    fds[PERF_LLC_MISSES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+                fds[PERF_DTLB_MISSES] = open(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB));
+                fds[PERF_BRANCH_MISSES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+                if (!available()) {
+                    error = std::string("perf_event_open failed: ") + std::strerror(errno);
+                    if (errno == EACCES || errno == EPERM)
+                        error += ", try kernel.perf_event_paranoid <= 2";
+                    else if (errno == ENOENT || errno == EOPNOTSUPP)
+                        error += ", no hardware PMU exposed (virtual machine?)";
+                }
+#else
+                error = "hardware counters are only supported on Linux";
+#endif
+            }
+
+            ~CounterSet() {
+#if defined(__linux__)
+                for (int fd : fds)
+                    if (fd >= 0) close(fd);
+#endif
+            }
+
+            CounterSet(const CounterSet&) = delete;
+            CounterSet& operator=(const CounterSet&) = delete;
+
+            bool available() const {
+                return std::any_of(std::begin(fds), std::end(fds), [](int fd) { return fd >= 0; });
+            }
+
+            const std::string& unavailableReason() const {
+                return error;
+            }
+
+            void start() {
+#if defined(__linux__)
+                for (int fd : fds) {
+                    if (fd < 0) continue;
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+#endif
+            }
+
+            // Nếu kernel phải chia sẻ PMU giữa nhiều event, giá trị được nhân theo thời gian thực chạy
+            PerfCounts stop() {
+                PerfCounts counts;
+#if defined(__linux__)
+                for (int fd : fds)
+                    if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+                    uint64_t buf[3];  // value, time enabled, time running
+                    if (fds[e] < 0 || read(fds[e], buf, sizeof(buf)) != sizeof(buf) || buf[2] == 0)
+                        continue;
+                    counts.value[e] = static_cast<long long>(buf[2] < buf[1] ? double(buf[0]) * buf[1] / buf[2] : buf[0]);
+                }
+#endif
+                return counts;
+            }
+        };
+
+        // Mở một lần cho cả tiến trình, báo một lần nếu không dùng được
+        CounterSet& counters() {
+            static CounterSet set;
+            static bool warned = false;
+            if (!set.available() && !warned) {
+                warned = true;
+                std::cerr << "note: hardware counters unavailable (" << set.unavailableReason() << ")\n";
+            }
+            return set;
+        }
+
+        // Chạy fn giữa start/stop, ghi bộ đếm vào sample; trả về thời gian (ns)
+        template <typename Fn>
+        double measure(PerfCounts& sample, Fn&& fn) {
+            CounterSet& set = counters();
+            set.start();
+            double ns = BenchmarkUtils::measure::elapsedNs(fn);
+            sample = set.stop();
+            return ns;
+        }
     }
 
     // Hàm tính thời gian thực hiện các thao tác trên bảng băm
     template <typename Table>
-    StatResult testTable(Table& table, const std::vector<std::pair<int, int>>& keyvals, const std::vector<int>& search_hit_indices, const std::vector<int>& search_miss_keys, const std::vector<int>& delete_indices) {
-        constexpr int NUM_RUNS = 3;
+    StatResult testTable(Table& table, const std::vector<std::pair<int, int>>& keyvals, const std::vector<int>& search_hit_indices, const std::vector<int>& search_miss_keys, const std::vector<int>& delete_indices, const measure::Config& cfg = measure::config) {
         StatResult res;
-        long long totalInsertTime = 0, totalSearchHitTime = 0, totalSearchMissTime = 0, totalDeleteTime = 0;
+        constexpr bool hasBatch = requires(Table& t, std::vector<int>& v, std::vector<bool>& f) { t.search_batch(v, v, f); };
+
+        // Chuẩn bị toàn bộ dữ liệu trước, ngoài vùng đo
+        std::vector<int> hitKeys, deleteKeys;
+        for (int idx : search_hit_indices)
+            hitKeys.push_back(keyvals[idx].first);
+        for (int idx : delete_indices)
+            deleteKeys.push_back(keyvals[idx].first);
+
+        // Cùng tập key với hai vòng search đơn lẻ để so sánh trực tiếp
+        std::vector<int> batchKeys = hitKeys;
+        batchKeys.insert(batchKeys.end(), search_miss_keys.begin(), search_miss_keys.end());
+        std::vector<int> batchValues;
+        std::vector<bool> batchFound;
+
+        // Giá trị mới cho các key insert lại sau khi xóa
+        std::vector<int> reinsertValues;
+        std::mt19937 rng = generator::makeRng();
+        std::uniform_int_distribution<int> dist_val(1, 1000000);
+        for (size_t i = 0; i < deleteKeys.size(); ++i)
+            reinsertValues.push_back(dist_val(rng));
+
+        // Thời gian (ns) mỗi lần đo và bộ đếm phần cứng cộng dồn cho từng pha
+        std::vector<double> insertNs, hitNs, missNs, batchNs, deleteNs, reinsertNs;
+        PerfCounts insertPerf, hitPerf, missPerf, batchPerf, deletePerf, reinsertPerf;
 
         // Thống kê probe cho từng loại search
         long long totalProbeSearchHit = 0, totalProbeSearchMiss = 0;
         long long totalProbeInsertAfterDelete = 0;
-        int nInsertAfterDelete = 0;
+        long long totalProbeMissAfterChurn = 0;
 
-        for (int run = 0; run < NUM_RUNS; ++run) {
-            Table tempTable(table); // clone
+        int runs = 0;
+        for (int rep = 0; rep < cfg.warmup + cfg.maxReps; ++rep) {
+            bool warmup = rep < cfg.warmup;
+            Table tempTable(table); // clone, ngoài vùng đo
+            int tmp;
+            volatile int sink = 0;  // giữ lại kết quả search để compiler không bỏ vòng lặp
+            PerfCounts pInsert, pHit, pMiss, pBatch, pDelete, pReinsert;
 
             // Insert all keyvals
-            auto t1 = std::chrono::high_resolution_clock::now();
-            for (auto& kv : keyvals)
-                tempTable.insert(kv.first, kv.second);
-            auto t2 = std::chrono::high_resolution_clock::now();
+            double tInsert = perf::measure(pInsert, [&] {
+                for (auto& kv : keyvals)
+                    tempTable.insert(kv.first, kv.second);
+            });
 
             // Search HIT (tồn tại)
-            int tmp;
-            auto t3 = std::chrono::high_resolution_clock::now();
-            for (int idx : search_hit_indices) {
-                int probes_before = tempTable.stats.totalProbesSearch;
-                tempTable.search(keyvals[idx].first, tmp);
-                totalProbeSearchHit += tempTable.stats.totalProbesSearch - probes_before;
-            }
-            auto t4 = std::chrono::high_resolution_clock::now();
+            long long probesBefore = tempTable.stats.totalProbesSearch;
+            double tHit = perf::measure(pHit, [&] {
+                for (int key : hitKeys)
+                    if (tempTable.search(key, tmp)) sink = tmp;
+            });
+            long long probesHit = tempTable.stats.totalProbesSearch - probesBefore;
 
             // Search MISS (không tồn tại)
-            auto t5 = std::chrono::high_resolution_clock::now();
-            for (int key : search_miss_keys) {
-                int probes_before = tempTable.stats.totalProbesSearch;
-                tempTable.search(key, tmp);
-                totalProbeSearchMiss += tempTable.stats.totalProbesSearch - probes_before;
+            probesBefore = tempTable.stats.totalProbesSearch;
+            double tMiss = perf::measure(pMiss, [&] {
+                for (int key : search_miss_keys)
+                    if (tempTable.search(key, tmp)) sink = tmp;
+            });
+            long long probesMiss = tempTable.stats.totalProbesSearch - probesBefore;
+
+            // Search batch (hash + prefetch theo cửa sổ)
+            double tBatch = 0;
+            if constexpr (hasBatch) {
+                tBatch = perf::measure(pBatch, [&] {
+                    tempTable.search_batch(batchKeys, batchValues, batchFound);
+                });
             }
-            auto t6 = std::chrono::high_resolution_clock::now();
 
             // Delete các key
-            auto t7 = std::chrono::high_resolution_clock::now();
-            for (int idx : delete_indices)
-                tempTable.erase(keyvals[idx].first);
-            auto t8 = std::chrono::high_resolution_clock::now();
+            double tDelete = perf::measure(pDelete, [&] {
+                for (int key : deleteKeys)
+                    tempTable.erase(key);
+            });
 
             // Insert lại các key vừa xóa (giá trị mới random)
-            std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
-            std::uniform_int_distribution<int> dist_val(1, 1000000);
-            for (int idx : delete_indices) {
-                int probes_before = tempTable.stats.totalProbesInsert;
-                tempTable.insert(keyvals[idx].first, dist_val(rng));
-                totalProbeInsertAfterDelete += tempTable.stats.totalProbesInsert - probes_before;
-                nInsertAfterDelete++;
-            }
-
-            // Tính thời gian từng phần (chia nhỏ rõ ràng)
-            totalInsertTime += std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
-            totalSearchHitTime += std::chrono::duration_cast<std::chrono::microseconds>(t4 - t3).count();
-            totalSearchMissTime += std::chrono::duration_cast<std::chrono::microseconds>(t6 - t5).count();
-            totalDeleteTime += std::chrono::duration_cast<std::chrono::microseconds>(t8 - t7).count();
+            probesBefore = tempTable.stats.totalProbesInsert;
+            double tReinsert = perf::measure(pReinsert, [&] {
+                for (size_t i = 0; i < deleteKeys.size(); ++i)
+                    tempTable.insert(deleteKeys[i], reinsertValues[i]);
+            });
+            long long probesReinsert = tempTable.stats.totalProbesInsert - probesBefore;
+
+            // Search MISS lần nữa: tombstone còn sót lại sẽ làm probe dài hơn lần đầu
+            probesBefore = tempTable.stats.totalProbesSearch;
+            for (int key : search_miss_keys)
+                tempTable.search(key, tmp);
+            long long probesChurn = tempTable.stats.totalProbesSearch - probesBefore;
+            (void)sink;
+
+            if (warmup) continue;
+
+            insertNs.push_back(tInsert);
+            hitNs.push_back(tHit);
+            missNs.push_back(tMiss);
+            batchNs.push_back(tBatch);
+            deleteNs.push_back(tDelete);
+            reinsertNs.push_back(tReinsert);
+            insertPerf.add(pInsert, keyvals.size());
+            hitPerf.add(pHit, hitKeys.size());
+            missPerf.add(pMiss, search_miss_keys.size());
+            deletePerf.add(pDelete, deleteKeys.size());
+            reinsertPerf.add(pReinsert, deleteKeys.size());
+            if (hasBatch)
+                batchPerf.add(pBatch, batchKeys.size());
+            totalProbeSearchHit += probesHit;
+            totalProbeSearchMiss += probesMiss;
+            totalProbeInsertAfterDelete += probesReinsert;
+            totalProbeMissAfterChurn += probesChurn;
 
             // Ghi lại stats (1 lần duy nhất)
-            if (run == 0)
+            if (runs++ == 0)
                 table.stats = tempTable.stats;
-        }
 
-        int nHit = search_hit_indices.size() * NUM_RUNS;
-        int nMiss = search_miss_keys.size() * NUM_RUNS;
+            // Dừng khi mọi pha có khoảng tin cậy đủ hẹp
+            bool done = measure::converged(insertNs, cfg) && measure::converged(hitNs, cfg) && measure::converged(missNs, cfg)
+                && measure::converged(deleteNs, cfg) && measure::converged(reinsertNs, cfg)
+                && (!hasBatch || measure::converged(batchNs, cfg));
+            if (done) break;
+        }
 
-        res.insertTime = totalInsertTime / NUM_RUNS;
-        res.searchTime = (totalSearchHitTime + totalSearchMissTime) / NUM_RUNS;
-        res.deleteTime = totalDeleteTime / NUM_RUNS;
+        res.runs = runs;
+        res.insertPhase = measure::summarize(insertNs, keyvals.size());
+        res.searchHitPhase = measure::summarize(hitNs, hitKeys.size());
+        res.searchMissPhase = measure::summarize(missNs, search_miss_keys.size());
+        res.deletePhase = measure::summarize(deleteNs, deleteKeys.size());
+        res.insertAfterDeletePhase = measure::summarize(reinsertNs, deleteKeys.size());
+        if (hasBatch)
+            res.batchSearchPhase = measure::summarize(batchNs, batchKeys.size());
+        res.insertPhase.perf = insertPerf;
+        res.searchHitPhase.perf = hitPerf;
+        res.searchMissPhase.perf = missPerf;
+        res.deletePhase.perf = deletePerf;
+        res.insertAfterDeletePhase.perf = reinsertPerf;
+        res.batchSearchPhase.perf = batchPerf;
+
+        auto toUs = [](double ns) { return (long long)std::llround(ns / 1000); };
+        res.insertTime = toUs(res.insertPhase.medianNs);
+        res.searchTime = toUs(res.searchHitPhase.medianNs + res.searchMissPhase.medianNs);
+        res.deleteTime = toUs(res.deletePhase.medianNs);
+        res.batchSearchTime = hasBatch ? toUs(res.batchSearchPhase.medianNs) : -1;
+        res.insertAfterDeleteTime = toUs(res.insertAfterDeletePhase.medianNs);
+
+        long long nHit = (long long)hitKeys.size() * runs;
+        long long nMiss = (long long)search_miss_keys.size() * runs;
+        long long nReinsert = (long long)deleteKeys.size() * runs;
         res.avgProbeSearchHit = (nHit ? 1.0 * totalProbeSearchHit / nHit : 0);
         res.avgProbeSearchMiss = (nMiss ? 1.0 * totalProbeSearchMiss / nMiss : 0);
-        res.avgProbeInsertAfterDelete = (nInsertAfterDelete ? 1.0 * totalProbeInsertAfterDelete / nInsertAfterDelete : 0);
+        res.avgProbeInsertAfterDelete = (nReinsert ? 1.0 * totalProbeInsertAfterDelete / nReinsert : 0);
+        res.avgProbeSearchMissAfterChurn = (nMiss ? 1.0 * totalProbeMissAfterChurn / nMiss : 0);
 
         return res;
     }
 
-    void runDynamicInsertExperiment(int M) {
+    // Chèn toàn bộ keyvals vào một bảng động, in một dòng thống kê
+    template <typename Table>
+    void runDynamicInsertRow(const std::string& patternName, const std::string& algoName, Table& table, const std::vector<std::pair<int, int>>& keyvals) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (const auto& kv : keyvals)
+            table.insert(kv.first, kv.second);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        long long time = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+
+        std::cout << std::left
+            << std::setw(12) << patternName
+            << std::setw(25) << algoName
+            << std::setw(15) << time
+            << std::setw(12) << table.size()
+            << std::setw(12) << helper::doubleToStr(table.loadFactor(), 4)
+            << std::setw(20) << table.maxClusterLength()
+            << std::setw(20) << helper::doubleToStr(table.avgClusterLength(), 4)
+            << '\n';
+    }
+
+    // Chèn toàn bộ keyvals vào một bảng động mới, lặp bằng measure::run đến khi hội tụ
+    template <typename Table>
+    PhaseStats measureDynamicInsert(const std::vector<std::pair<int, int>>& keyvals) {
+        volatile int sink = 0;
+        PhaseStats ps = measure::run(keyvals.size(), [&] {
+            Table table(17);
+            for (const auto& kv : keyvals)
+                table.insert(kv.first, kv.second);
+            sink = table.size();
+        });
+        (void)sink;
+        return ps;
+    }
+
+    // a nhanh hơn b khi khoảng tin cậy 95% của hai mean không chồng lên nhau
+    inline bool fasterWithCI(const PhaseStats& a, const PhaseStats& b) {
+        return a.meanNs + a.ci95Ns < b.meanNs - b.ci95Ns;
+    }
+
+    inline std::string nsPerOpWithCI(const PhaseStats& ps) {
+        return helper::doubleToStr(ps.meanNs / ps.ops) + " +- " + helper::doubleToStr(ps.ci95Ns / ps.ops);
+    }
+
+    // Chạy đủ các pha của testTable trên Dynamic Double với Sizing đã thắng ở phân bố này
+    template <typename Sizing>
+    void runBestSizingRow(const std::string& sizingName, const Workload& w) {
+        DynamicDoubleHashTable<int, int, AoSSlots, Sizing> table(17);
+        StatResult r = testTable(table, w.keyvals, w.search_hit_indices, w.search_miss_keys, w.delete_indices);
+        std::cout << std::left
+            << std::setw(12) << w.patternName
+            << std::setw(15) << sizingName
+            << std::setw(15) << helper::doubleToStr(r.insertPhase.nsPerOp)
+            << std::setw(15) << helper::doubleToStr(r.searchHitPhase.nsPerOp)
+            << std::setw(15) << helper::doubleToStr(r.searchMissPhase.nsPerOp)
+            << std::setw(15) << helper::doubleToStr(r.deletePhase.nsPerOp)
+            << '\n';
+    }
+
+    void runDynamicInsertExperiment(int M, double miss_rate) {
         std::cout << "\n=== DYNAMIC TABLE TEST: INSERT M ITEMS ===\n";
 
         // In header bảng thống kê
@@ -1079,79 +4208,343 @@ namespace BenchmarkUtils {
             << std::setw(20) << "AvgClusterLen" << '\n';
         std::cout << std::string(116, '-') << '\n';
 
+        std::vector<Workload> workloads;
         for (int pattern = 1; pattern <= 3; ++pattern) {
-            std::string patternName;
-            std::vector<std::pair<int, int>> keyvals;
+            workloads.push_back(makeWorkload(pattern, M, miss_rate, M * 10));
+            const std::string& patternName = workloads.back().patternName;
+            const auto& keyvals = workloads.back().keyvals;
 
-            if (pattern == 1) {
-                patternName = "RANDOM";
-                keyvals = BenchmarkUtils::generator::generateRandomKeyVals(M, M * 10);
-            }
-            else if (pattern == 2) {
-                patternName = "SEQUENTIAL";
-                keyvals = BenchmarkUtils::generator::generateSequentialKeyVals(M);
+            DynamicLinearHashTable<int, int> dlt(17);
+            runDynamicInsertRow(patternName, "Dynamic Linear", dlt, keyvals);
+
+            DynamicQuadraticHashTable<int, int> dqt(17);
+            runDynamicInsertRow(patternName, "Dynamic Quadratic", dqt, keyvals);
+
+            DynamicDoubleHashTable<int, int> ddt(17);
+            runDynamicInsertRow(patternName, "Dynamic Double", ddt, keyvals);
+
+            // Dynamic Double, layout SoA
+            DynamicDoubleHashTable<int, int, SoASlots> dst(17);
+            runDynamicInsertRow(patternName, "Dynamic Double (SoA)", dst, keyvals);
+
+            // Dynamic Double, kích thước lũy thừa của 2 với bước nhảy lẻ
+            DynamicDoubleHashTable<int, int, AoSSlots, Pow2Sizing> dpt(17);
+            runDynamicInsertRow(patternName, "Dynamic Double (Pow2)", dpt, keyvals);
+
+            // Dynamic Double, rehash tăng dần
+            DynamicDoubleHashTable<int, int> dit(17, true);
+            runDynamicInsertRow(patternName, "Dynamic Double (Incr)", dit, keyvals);
+        }
+
+        // Chọn sizing cho Dynamic Double theo từng phân bố: đo chèn lặp lại với measure::run,
+        // chỉ đổi sang Pow2Sizing khi khoảng tin cậy tách hẳn, còn lại giữ PrimeSizing mặc định
+        std::cout << "\n=== DYNAMIC DOUBLE SIZING: INSERT ns/op (mean +- 95% CI) ===\n";
+        std::cout << std::left
+            << std::setw(12) << "Pattern"
+            << std::setw(22) << "PrimeSizing"
+            << std::setw(22) << "Pow2Sizing"
+            << std::setw(15) << "Winner" << '\n';
+        std::cout << std::string(71, '-') << '\n';
+        std::vector<bool> pow2Wins;
+        for (const Workload& w : workloads) {
+            PhaseStats prime = measureDynamicInsert<DynamicDoubleHashTable<int, int>>(w.keyvals);
+            PhaseStats pow2 = measureDynamicInsert<DynamicDoubleHashTable<int, int, AoSSlots, Pow2Sizing>>(w.keyvals);
+            bool pow2Win = fasterWithCI(pow2, prime);
+            bool primeWin = fasterWithCI(prime, pow2);
+            pow2Wins.push_back(pow2Win);
+            std::cout << std::left
+                << std::setw(12) << w.patternName
+                << std::setw(22) << nsPerOpWithCI(prime)
+                << std::setw(22) << nsPerOpWithCI(pow2)
+                << std::setw(15) << (pow2Win ? "Pow2Sizing" : primeWin ? "PrimeSizing" : "tie (Prime)") << '\n';
+        }
+
+        std::cout << "\n=== DYNAMIC DOUBLE WITH THE WINNING SIZING (ns/op) ===\n";
+        std::cout << std::left
+            << std::setw(12) << "Pattern"
+            << std::setw(15) << "Sizing"
+            << std::setw(15) << "Insert"
+            << std::setw(15) << "SearchHit"
+            << std::setw(15) << "SearchMiss"
+            << std::setw(15) << "Delete" << '\n';
+        std::cout << std::string(87, '-') << '\n';
+        for (size_t i = 0; i < workloads.size(); ++i) {
+            if (pow2Wins[i])
+                runBestSizingRow<Pow2Sizing>("Pow2Sizing", workloads[i]);
+            else
+                runBestSizingRow<PrimeSizing>("PrimeSizing", workloads[i]);
+        }
+
+        std::cout << "\n=== FINISHED DYNAMIC TABLE TEST ===\n";
+    }
+
+    // Đo độ trễ từng lần insert (ns) để thấy đỉnh do rehash toàn bộ một lần
+    template <typename Table>
+    void runInsertLatencyRow(const std::string& algoName, Table& table, const std::vector<std::pair<int, int>>& keyvals) {
+        table.stats.enableHistograms();
+        for (const auto& kv : keyvals)
+            table.insert(kv.first, kv.second);
+        const LogHistogram& latency = table.stats.hist->latency[HIST_INSERT];
+
+        std::cout << std::left
+            << std::setw(25) << algoName
+            << std::setw(12) << latency.percentile(50)
+            << std::setw(12) << latency.percentile(99)
+            << std::setw(12) << latency.percentile(99.9)
+            << std::setw(15) << latency.max()
+            << '\n';
+    }
+
+    void runInsertLatencyExperiment(int M) {
+        std::cout << "\n=== INSERT LATENCY: STOP-THE-WORLD VS INCREMENTAL REHASH (ns) ===\n";
+        std::cout << std::left
+            << std::setw(25) << "Algorithm"
+            << std::setw(12) << "p50"
+            << std::setw(12) << "p99"
+            << std::setw(12) << "p99.9"
+            << std::setw(15) << "max" << '\n';
+        std::cout << std::string(76, '-') << '\n';
+
+        auto keyvals = BenchmarkUtils::generator::generateRandomKeyVals(M, M * 10);
+
+        DynamicDoubleHashTable<int, int> ddt(17);
+        runInsertLatencyRow("Dynamic Double", ddt, keyvals);
+
+        DynamicDoubleHashTable<int, int> dit(17, true);
+        runInsertLatencyRow("Dynamic Double (Incr)", dit, keyvals);
+    }
+
+    // Một reader tra liên tục các key có sẵn trong khi writer chèn thêm M key (bảng nhân đôi
+    // nhiều lần); in phân vị độ trễ của reader
+    template <typename Search, typename Insert>
+    void runConcurrentResizeRow(const std::string& algoName, const std::vector<std::pair<int, int>>& keyvals, int numPreloaded, Search search, Insert insert) {
+        std::atomic<bool> writerDone{ false };
+        std::vector<long long> latencies;
+        latencies.reserve(1 << 20);
+
+        std::thread reader([&] {
+            int val;
+            size_t i = 0;
+            while (!writerDone.load(std::memory_order_acquire)) {
+                int key = keyvals[i++ % numPreloaded].first;
+                auto t1 = std::chrono::steady_clock::now();
+                search(key, val);
+                auto t2 = std::chrono::steady_clock::now();
+                latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count());
             }
-            else {
-                patternName = "CLUSTERED";
-                keyvals = BenchmarkUtils::generator::generateClusteredKeyVals(M, M * 10);
+        });
+        for (size_t i = numPreloaded; i < keyvals.size(); ++i)
+            insert(keyvals[i].first, keyvals[i].second);
+        writerDone.store(true, std::memory_order_release);
+        reader.join();
+
+        if (latencies.empty()) latencies.push_back(0);
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << std::left
+            << std::setw(30) << algoName
+            << std::setw(12) << latencies.size()
+            << std::setw(10) << helper::percentile(latencies, 50)
+            << std::setw(10) << helper::percentile(latencies, 99)
+            << std::setw(12) << helper::percentile(latencies, 99.9)
+            << std::setw(15) << latencies.back()
+            << '\n';
+    }
+
+    // Reader-writer lock quanh DynamicDoubleHashTable so với bảng RCU: reader của bảng
+    // RCU không bao giờ phải chờ rehash
+    void runConcurrentResizeExperiment(int M) {
+        std::cout << "\n=== READ LATENCY DURING RESIZE: SHARED_MUTEX VS RCU (ns) ===\n";
+        std::cout << std::left
+            << std::setw(30) << "Algorithm"
+            << std::setw(12) << "lookups"
+            << std::setw(10) << "p50"
+            << std::setw(10) << "p99"
+            << std::setw(12) << "p99.9"
+            << std::setw(15) << "max" << '\n';
+        std::cout << std::string(89, '-') << '\n';
+
+        auto keyvals = BenchmarkUtils::generator::generateRandomKeyVals(M, M * 10);
+        int numPreloaded = std::max(1, M / 10);
+
+        // Search dưới shared lock vẫn cập nhật thống kê: cần bộ đếm an toàn đa luồng
+        DynamicDoubleHashTable<int, int, AoSSlots, PrimeSizing, HashUtils::MixHash<int>, ShardedStats> locked(17);
+        std::shared_mutex rw;
+        for (int i = 0; i < numPreloaded; ++i)
+            locked.insert(keyvals[i].first, keyvals[i].second);
+        runConcurrentResizeRow("Dynamic Double + rwlock", keyvals, numPreloaded,
+            [&](int key, int& val) { std::shared_lock<std::shared_mutex> lock(rw); return locked.search(key, val); },
+            [&](int key, int val) { std::unique_lock<std::shared_mutex> lock(rw); return locked.insert(key, val); });
+
+        RcuDynamicDoubleHashTable<int, int> rcu(17);
+        for (int i = 0; i < numPreloaded; ++i)
+            rcu.insert(keyvals[i].first, keyvals[i].second);
+        runConcurrentResizeRow("RCU Dynamic Double", keyvals, numPreloaded,
+            [&](int key, int& val) { return rcu.search(key, val); },
+            [&](int key, int val) { return rcu.insert(key, val); });
+    }
+
+    // Bảng đơn luồng bọc trong reader-writer lock, làm mốc cho benchmark đa luồng.
+    // Nhiều reader cùng gọi search nên Table phải dùng ShardedStats (hoặc NoStats)
+    template <typename Table>
+    struct RwLockedTable {
+        static_assert(!std::is_same_v<decltype(Table::stats), HashStats>, "concurrent readers need thread-safe stats");
+        Table table;
+        std::shared_mutex rw;
+
+        bool insert(int key, int value) {
+            std::unique_lock<std::shared_mutex> lock(rw);
+            return table.insert(key, value);
+        }
+        bool search(int key, int& value) {
+            std::shared_lock<std::shared_mutex> lock(rw);
+            return table.search(key, value);
+        }
+        void erase(int key) {
+            std::unique_lock<std::shared_mutex> lock(rw);
+            table.erase(key);
+        }
+    };
+
+    // Chạy cùng một khối lượng totalOps (chia đều cho các thread) trên một bảng mới cho mỗi
+    // số thread; key lấy từ tập cố định [0, universe) nên bảng kích thước cố định không đầy.
+    // readPercent % là search, phần còn lại chia đôi insert/erase
+    template <typename MakeTable>
+    void runScalingRow(const std::string& algoName, MakeTable makeTable, const std::vector<int>& threadCounts, int universe, long long totalOps, int readPercent) {
+        double baseMops = 0;
+        for (int threads : threadCounts) {
+            auto table = makeTable();
+            for (int k = 0; k < universe; k += 2)
+                table->insert(k, k);
+
+            long long opsPerThread = totalOps / threads;
+            std::latch start(threads + 1);
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    std::mt19937 rng(12345 + t);
+                    std::uniform_int_distribution<int> dist_key(0, universe - 1), dist_pct(0, 99);
+                    int val;
+                    start.arrive_and_wait();
+                    for (long long i = 0; i < opsPerThread; ++i) {
+                        int key = dist_key(rng);
+                        int pct = dist_pct(rng);
+                        if (pct < readPercent) table->search(key, val);
+                        else if (pct & 1) table->insert(key, key);
+                        else table->erase(key);
+                    }
+                });
             }
+            start.arrive_and_wait();
+            auto t1 = std::chrono::steady_clock::now();
+            for (auto& w : workers) w.join();
+            auto t2 = std::chrono::steady_clock::now();
 
-            // Dynamic Linear
-            DynamicLinearHashTable<int, int> dlt(17);
-            auto t1 = std::chrono::high_resolution_clock::now();
-            for (const auto& kv : keyvals)
-                dlt.insert(kv.first, kv.second);
-            auto t2 = std::chrono::high_resolution_clock::now();
-            long long time_dlt = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+            double us = std::max<long long>(1, std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count());
+            double mops = opsPerThread * threads / us;
+            if (baseMops == 0) baseMops = mops / threads;  // thông lượng mỗi thread ở số thread nhỏ nhất
+            double efficiency = 100.0 * mops / (threads * baseMops);
 
             std::cout << std::left
-                << std::setw(12) << patternName
-                << std::setw(25) << "Dynamic Linear"
-                << std::setw(15) << time_dlt
-                << std::setw(12) << dlt.size()
-                << std::setw(12) << helper::doubleToStr(dlt.loadFactor(), 4)
-                << std::setw(20) << dlt.maxClusterLength()
-                << std::setw(20) << helper::doubleToStr(dlt.avgClusterLength(), 4)
+                << std::setw(25) << algoName
+                << std::setw(10) << threads
+                << std::setw(12) << helper::doubleToStr(mops, 3)
+                << std::setw(15) << helper::doubleToStr(mops / threads, 3)
+                << std::setw(15) << helper::doubleToStr(efficiency, 1) + "%"
                 << '\n';
+        }
+    }
 
-            // Dynamic Quadratic
-            DynamicQuadraticHashTable<int, int> dqt(17);
-            auto t3 = std::chrono::high_resolution_clock::now();
-            for (const auto& kv : keyvals)
-                dqt.insert(kv.first, kv.second);
-            auto t4 = std::chrono::high_resolution_clock::now();
-            long long time_dqt = std::chrono::duration_cast<std::chrono::microseconds>(t4 - t3).count();
+    // Thông lượng (Mops/s) của các bảng thread-safe ở 1, 2, 4 ... N thread với hai tỷ lệ đọc/ghi
+    void runScalingExperiment(int M, int maxThreads = static_cast<int>(std::thread::hardware_concurrency())) {
+        maxThreads = std::max(1, maxThreads);
+        std::vector<int> threadCounts;
+        for (int t = 1; t < maxThreads; t *= 2)
+            threadCounts.push_back(t);
+        threadCounts.push_back(maxThreads);
 
+        int universe = std::max(1, M);
+        long long totalOps = std::max(1000000LL, 4LL * M);
+        int capacity = helper::nextPrime(2 * universe);
+
+        for (int readPercent : { 90, 50 }) {
+            std::cout << "\n=== THROUGHPUT SCALING: " << readPercent << "% READ / " << 100 - readPercent << "% WRITE ===\n";
             std::cout << std::left
-                << std::setw(12) << patternName
-                << std::setw(25) << "Dynamic Quadratic"
-                << std::setw(15) << time_dqt
-                << std::setw(12) << dqt.size()
-                << std::setw(12) << helper::doubleToStr(dqt.loadFactor(), 4)
-                << std::setw(20) << dqt.maxClusterLength()
-                << std::setw(20) << helper::doubleToStr(dqt.avgClusterLength(), 4)
-                << '\n';
+                << std::setw(25) << "Algorithm"
+                << std::setw(10) << "Threads"
+                << std::setw(12) << "Mops/s"
+                << std::setw(15) << "Mops/s/thread"
+                << std::setw(15) << "Efficiency" << '\n';
+            std::cout << std::string(77, '-') << '\n';
+
+            runScalingRow("Dynamic Double + rwlock", [] { return std::make_unique<RwLockedTable<DynamicDoubleHashTable<int, int, AoSSlots, PrimeSizing, HashUtils::MixHash<int>, ShardedStats>>>(); },
+                threadCounts, universe, totalOps, readPercent);
+            runScalingRow("Concurrent Double (CAS)", [capacity] { return std::make_unique<ConcurrentDoubleHashTable<int, int>>(capacity); },
+                threadCounts, universe, totalOps, readPercent);
+            runScalingRow("RCU Dynamic Double", [] { return std::make_unique<RcuDynamicDoubleHashTable<int, int>>(17); },
+                threadCounts, universe, totalOps, readPercent);
+            runScalingRow("Sharded Double x16", [] { return std::make_unique<ShardedHashTable<int, int>>(16, 17); },
+                threadCounts, universe, totalOps, readPercent);
+        }
+    }
 
-            // Dynamic Double
-            DynamicDoubleHashTable<int, int> ddt(17);
-            auto t5 = std::chrono::high_resolution_clock::now();
-            for (const auto& kv : keyvals)
-                ddt.insert(kv.first, kv.second);
-            auto t6 = std::chrono::high_resolution_clock::now();
-            long long time_ddt = std::chrono::duration_cast<std::chrono::microseconds>(t6 - t5).count();
+    // Đo một kiểu tra cứu trên toàn bộ queries, trả về ns/lookup (median các lần đo)
+    template <typename Lookup>
+    double timeLookups(int numQueries, Lookup lookup) {
+        return measure::run(numQueries, lookup).nsPerOp;
+    }
+
+    // So sánh search từng key, search_batch (prefetch slot đầu) và search_interleaved
+    // (coroutine, prefetch mọi bước) trên bảng double hashing với nhiều tỷ lệ miss
+    void runInterleavedLookupExperiment(int M, double lf, double userMissRate) {
+        std::cout << "\n=== INTERLEAVED LOOKUP: PER-KEY VS BATCH VS COROUTINE (ns/lookup) ===\n";
+        std::cout << std::left
+            << std::setw(12) << "Miss rate"
+            << std::setw(15) << "search"
+            << std::setw(15) << "batch"
+            << std::setw(15) << "interleaved"
+            << std::setw(15) << "speedup" << '\n';
+        std::cout << std::string(72, '-') << '\n';
+
+        int N = helper::nextPrime(int(M / lf));
+        auto keyvals = BenchmarkUtils::generator::generateRandomKeyVals(M, N * 10);
+        DoubleHashTable<int, int> table(N);
+        for (const auto& kv : keyvals)
+            table.insert(kv.first, kv.second);
+
+        std::unordered_set<int> exist_keys;
+        for (const auto& kv : keyvals) exist_keys.insert(kv.first);
+
+        std::vector<double> missRates = { 0.0, 0.5, 1.0, userMissRate };
+        std::sort(missRates.begin(), missRates.end());
+        missRates.erase(std::unique(missRates.begin(), missRates.end()), missRates.end());
+
+        std::mt19937 rng = generator::makeRng();
+        for (double missRate : missRates) {
+            int num_miss = int(M * missRate + 0.5);
+            std::vector<int> queries = BenchmarkUtils::generator::generateMissKeys(num_miss, exist_keys, N * 10);
+            for (int i = num_miss; i < M; ++i)
+                queries.push_back(keyvals[rng() % keyvals.size()].first);
+            std::shuffle(queries.begin(), queries.end(), rng);
+
+            int n = static_cast<int>(queries.size());
+            std::vector<int> out;
+            std::vector<bool> found;
+            int tmp;
+            double perKey = timeLookups(n, [&] {
+                for (int key : queries)
+                    table.search(key, tmp);
+            });
+            double batch = timeLookups(n, [&] { table.search_batch(queries, out, found); });
+            double interleaved = timeLookups(n, [&] { table.search_interleaved(queries, out, found); });
 
             std::cout << std::left
-                << std::setw(12) << patternName
-                << std::setw(25) << "Dynamic Double"
-                << std::setw(15) << time_ddt
-                << std::setw(12) << ddt.size()
-                << std::setw(12) << helper::doubleToStr(ddt.loadFactor(), 4)
-                << std::setw(20) << ddt.maxClusterLength()
-                << std::setw(20) << helper::doubleToStr(ddt.avgClusterLength(), 4)
+                << std::setw(12) << helper::doubleToStr(missRate)
+                << std::setw(15) << helper::doubleToStr(perKey)
+                << std::setw(15) << helper::doubleToStr(batch)
+                << std::setw(15) << helper::doubleToStr(interleaved)
+                << std::setw(15) << (interleaved > 0 ? helper::doubleToStr(perKey / interleaved) + "x" : std::string("-"))
                 << '\n';
         }
-
-        std::cout << "\n=== FINISHED DYNAMIC TABLE TEST ===\n";
     }
 
     namespace printOutput {
@@ -1160,82 +4553,89 @@ namespace BenchmarkUtils {
             std::cout << "TABLE_SIZE with load factor 2 (" << lf2 << "): " << N2 << '\n';
         }
 
+        // Một cột trong bảng so sánh: tên thuật toán + kết quả với LF1, LF2
+        struct SummaryColumn {
+            std::string name;
+            StatResult lf1;
+            StatResult lf2;
+        };
+
+        template<typename Getter>
+        void printSummaryRow(const std::string& label, const std::vector<SummaryColumn>& cols, Getter get) {
+            std::cout << std::setw(50) << std::left << label;
+            for (const auto& col : cols)
+                std::cout << std::setw(20) << get(col);
+            std::cout << '\n';
+        }
+
         // Hàm in bảng thống kê tổng hợp thời gian thực hiện các thao tác
-        void printSummaryTable(double lf1, double lf2, const StatResult& dht1, const StatResult& dht2, const StatResult& lpt1, const StatResult& lpt2, const StatResult& qpt1, const StatResult& qpt2) {
+        void printSummaryTable(double lf1, double lf2, const std::vector<SummaryColumn>& cols) {
             std::cout << "\n===== TABLE OF PERFORMANCE COMPARISON (us) =====\n";
-            std::cout << std::setw(50) << std::left << " "
-                << std::setw(20) << "Double Hashing"
-                << std::setw(20) << "Linear Probing"
-                << std::setw(20) << "Quadratic Probing" << '\n';
+            printSummaryRow(" ", cols, [](const SummaryColumn& c) { return c.name; });
 
             // Thời gian thực hiện các thao tác
-            std::cout << std::setw(50) << std::left << ("[Insert Time] LF1 (" + helper::doubleToStr(lf1) + "):")
-                << std::setw(20) << dht1.insertTime
-                << std::setw(20) << lpt1.insertTime
-                << std::setw(20) << qpt1.insertTime << '\n';
-
-            std::cout << std::setw(50) << std::left << ("[Insert Time] LF2 (" + helper::doubleToStr(lf2) + "):")
-                << std::setw(20) << dht2.insertTime
-                << std::setw(20) << lpt2.insertTime
-                << std::setw(20) << qpt2.insertTime << '\n';
-
-            std::cout << std::setw(50) << std::left << ("[Search Time] LF1 (" + helper::doubleToStr(lf1) + "):")
-                << std::setw(20) << dht1.searchTime
-                << std::setw(20) << lpt1.searchTime
-                << std::setw(20) << qpt1.searchTime << '\n';
-
-            std::cout << std::setw(50) << std::left << ("[Search Time] LF2 (" + helper::doubleToStr(lf2) + "):")
-                << std::setw(20) << dht2.searchTime
-                << std::setw(20) << lpt2.searchTime
-                << std::setw(20) << qpt2.searchTime << '\n';
-
-            std::cout << std::setw(50) << std::left << ("[Delete Time] LF1 (" + helper::doubleToStr(lf1) + "):")
-                << std::setw(20) << dht1.deleteTime
-                << std::setw(20) << lpt1.deleteTime
-                << std::setw(20) << qpt1.deleteTime << '\n';
-
-            std::cout << std::setw(50) << std::left << ("[Delete Time] LF2 (" + helper::doubleToStr(lf2) + "):")
-                << std::setw(20) << dht2.deleteTime
-                << std::setw(20) << lpt2.deleteTime
-                << std::setw(20) << qpt2.deleteTime << '\n';
+            printSummaryRow("[Insert Time] LF1 (" + helper::doubleToStr(lf1) + "):", cols, [](const SummaryColumn& c) { return c.lf1.insertTime; });
+            printSummaryRow("[Insert Time] LF2 (" + helper::doubleToStr(lf2) + "):", cols, [](const SummaryColumn& c) { return c.lf2.insertTime; });
+            printSummaryRow("[Search Time] LF1 (" + helper::doubleToStr(lf1) + "):", cols, [](const SummaryColumn& c) { return c.lf1.searchTime; });
+            printSummaryRow("[Search Time] LF2 (" + helper::doubleToStr(lf2) + "):", cols, [](const SummaryColumn& c) { return c.lf2.searchTime; });
+            printSummaryRow("[Delete Time] LF1 (" + helper::doubleToStr(lf1) + "):", cols, [](const SummaryColumn& c) { return c.lf1.deleteTime; });
+            printSummaryRow("[Delete Time] LF2 (" + helper::doubleToStr(lf2) + "):", cols, [](const SummaryColumn& c) { return c.lf2.deleteTime; });
+            auto batchTime = [](long long t) { return t < 0 ? std::string("n/a") : std::to_string(t); };
+            printSummaryRow("[Batch Search Time] LF1 (" + helper::doubleToStr(lf1) + "):", cols, [&](const SummaryColumn& c) { return batchTime(c.lf1.batchSearchTime); });
+            printSummaryRow("[Batch Search Time] LF2 (" + helper::doubleToStr(lf2) + "):", cols, [&](const SummaryColumn& c) { return batchTime(c.lf2.batchSearchTime); });
+            printSummaryRow("[Insert-after-delete Time] LF1 (" + helper::doubleToStr(lf1) + "):", cols, [](const SummaryColumn& c) { return c.lf1.insertAfterDeleteTime; });
+            printSummaryRow("[Insert-after-delete Time] LF2 (" + helper::doubleToStr(lf2) + "):", cols, [](const SummaryColumn& c) { return c.lf2.insertAfterDeleteTime; });
+
+            // ns/op theo median, kèm nửa độ rộng khoảng tin cậy 95% (% mean)
+            std::cout << "\n----- NS PER OPERATION (median +- 95% CI) -----\n";
+            auto perOp = [](const PhaseStats& ps) { return helper::doubleToStr(ps.nsPerOp, 1) + " +-" + helper::doubleToStr(100 * ps.relCI(), 1) + "%"; };
+            printSummaryRow("[Insert ns/op] LF1:", cols, [&](const SummaryColumn& c) { return perOp(c.lf1.insertPhase); });
+            printSummaryRow("[Search HIT ns/op] LF1:", cols, [&](const SummaryColumn& c) { return perOp(c.lf1.searchHitPhase); });
+            printSummaryRow("[Search MISS ns/op] LF1:", cols, [&](const SummaryColumn& c) { return perOp(c.lf1.searchMissPhase); });
+            printSummaryRow("[Delete ns/op] LF1:", cols, [&](const SummaryColumn& c) { return perOp(c.lf1.deletePhase); });
+            printSummaryRow("[Insert-after-delete ns/op] LF1:", cols, [&](const SummaryColumn& c) { return perOp(c.lf1.insertAfterDeletePhase); });
+            printSummaryRow("[Insert ns/op] LF2:", cols, [&](const SummaryColumn& c) { return perOp(c.lf2.insertPhase); });
+            printSummaryRow("[Search HIT ns/op] LF2:", cols, [&](const SummaryColumn& c) { return perOp(c.lf2.searchHitPhase); });
+            printSummaryRow("[Search MISS ns/op] LF2:", cols, [&](const SummaryColumn& c) { return perOp(c.lf2.searchMissPhase); });
+            printSummaryRow("[Delete ns/op] LF2:", cols, [&](const SummaryColumn& c) { return perOp(c.lf2.deletePhase); });
+            printSummaryRow("[Insert-after-delete ns/op] LF2:", cols, [&](const SummaryColumn& c) { return perOp(c.lf2.insertAfterDeletePhase); });
+            printSummaryRow("[Measured runs] LF1 / LF2:", cols, [](const SummaryColumn& c) { return std::to_string(c.lf1.runs) + " / " + std::to_string(c.lf2.runs); });
+
+            // Bộ đếm phần cứng mỗi thao tác: giải thích vì sao ít probe hơn chưa chắc nhanh hơn
+            std::cout << "\n----- HARDWARE COUNTERS PER OPERATION (LF1) -----\n";
+            if (!perf::counters().available()) {
+                std::cout << "n/a: " << perf::counters().unavailableReason() << '\n';
+            }
+            else {
+                auto perOp = [](const PhaseStats& ps, int e) { return ps.perf.valid(e) ? helper::doubleToStr(ps.perf.perOp(e), 3) : std::string("n/a"); };
+                const std::pair<const char*, PhaseStats StatResult::*> phases[] = {
+                    { "insert", &StatResult::insertPhase },
+                    { "search HIT", &StatResult::searchHitPhase },
+                    { "search MISS", &StatResult::searchMissPhase },
+                };
+                for (const auto& [phaseName, phase] : phases)
+                    for (int e = 0; e < PERF_EVENT_COUNT; ++e)
+                        printSummaryRow(std::string("[") + PERF_EVENT_NAMES[e] + "/op] " + phaseName + ":", cols,
+                            [&](const SummaryColumn& c) { return perOp(c.lf1.*phase, e); });
+            }
 
             // In probe search hit/miss/insert after delete 
             std::cout << "\n----- PROBE STATISTICS (Average probes per operation) -----\n";
-            std::cout << std::setw(50) << std::left << "[Avg probe/search HIT] LF1:"
-                << std::setw(20) << dht1.avgProbeSearchHit
-                << std::setw(20) << lpt1.avgProbeSearchHit
-                << std::setw(20) << qpt1.avgProbeSearchHit << '\n';
-
-            std::cout << std::setw(50) << std::left << "[Avg probe/search MISS] LF1:"
-                << std::setw(20) << dht1.avgProbeSearchMiss
-                << std::setw(20) << lpt1.avgProbeSearchMiss
-                << std::setw(20) << qpt1.avgProbeSearchMiss << '\n';
-
-            std::cout << std::setw(50) << std::left << "[Avg probe/insert-after-delete] LF1:"
-                << std::setw(20) << dht1.avgProbeInsertAfterDelete
-                << std::setw(20) << lpt1.avgProbeInsertAfterDelete
-                << std::setw(20) << qpt1.avgProbeInsertAfterDelete << '\n';
-
-            std::cout << std::setw(50) << std::left << "[Avg probe/search HIT] LF2:"
-                << std::setw(20) << dht2.avgProbeSearchHit
-                << std::setw(20) << lpt2.avgProbeSearchHit
-                << std::setw(20) << qpt2.avgProbeSearchHit << '\n';
-
-            std::cout << std::setw(50) << std::left << "[Avg probe/search MISS] LF2:"
-                << std::setw(20) << dht2.avgProbeSearchMiss
-                << std::setw(20) << lpt2.avgProbeSearchMiss
-                << std::setw(20) << qpt2.avgProbeSearchMiss << '\n';
-
-            std::cout << std::setw(50) << std::left << "[Avg probe/insert-after-delete] LF2:"
-                << std::setw(20) << dht2.avgProbeInsertAfterDelete
-                << std::setw(20) << lpt2.avgProbeInsertAfterDelete
-                << std::setw(20) << qpt2.avgProbeInsertAfterDelete << '\n';
+            printSummaryRow("[Avg probe/search HIT] LF1:", cols, [](const SummaryColumn& c) { return c.lf1.avgProbeSearchHit; });
+            printSummaryRow("[Avg probe/search MISS] LF1:", cols, [](const SummaryColumn& c) { return c.lf1.avgProbeSearchMiss; });
+            printSummaryRow("[Avg probe/insert-after-delete] LF1:", cols, [](const SummaryColumn& c) { return c.lf1.avgProbeInsertAfterDelete; });
+            printSummaryRow("[Avg probe/search MISS after churn] LF1:", cols, [](const SummaryColumn& c) { return c.lf1.avgProbeSearchMissAfterChurn; });
+            printSummaryRow("[Avg probe/search HIT] LF2:", cols, [](const SummaryColumn& c) { return c.lf2.avgProbeSearchHit; });
+            printSummaryRow("[Avg probe/search MISS] LF2:", cols, [](const SummaryColumn& c) { return c.lf2.avgProbeSearchMiss; });
+            printSummaryRow("[Avg probe/insert-after-delete] LF2:", cols, [](const SummaryColumn& c) { return c.lf2.avgProbeInsertAfterDelete; });
+            printSummaryRow("[Avg probe/search MISS after churn] LF2:", cols, [](const SummaryColumn& c) { return c.lf2.avgProbeSearchMissAfterChurn; });
         }
 
         // Hàm in bảng thống kê chi tiết về số lần probe, số lần va chạm và tỷ lệ va chạm
         template <typename Table>
         void printDetailStats(const std::string& algoName, double lf, Table& table) {
             const auto& stats = table.stats;
+            static_assert(std::remove_cvref_t<decltype(stats)>::ENABLED, "printDetailStats needs a table with stats enabled");
 
             double avgInsertProbes = (stats.nInsert > 0) ? 1.0 * stats.totalProbesInsert / stats.nInsert : 0;
             double collisionRate = (stats.nInsert > 0) ? 100.0 * stats.totalCollision / stats.nInsert : 0;
@@ -1271,10 +4671,437 @@ namespace BenchmarkUtils {
                 << '\n';
             std::cout << std::string(120, '-') << '\n';
         }
+
+        void printHistogramHeader(void) {
+            std::cout << std::left << std::setw(25) << "Algorithm"
+                << std::setw(13) << "Operation"
+                << std::setw(10) << "Count"
+                << std::setw(10) << "p50"
+                << std::setw(10) << "p99"
+                << std::setw(10) << "p99.9"
+                << std::setw(12) << "max"
+                << std::setw(10) << "Probe50"
+                << std::setw(10) << "Probe99"
+                << std::setw(10) << "Probe99.9"
+                << std::setw(10) << "ProbeMax"
+                << '\n';
+            std::cout << std::string(130, '-') << '\n';
+        }
+
+        // Mỗi loại thao tác một dòng; bảng chưa bật histogram thì không in gì
+        void printHistogramStats(const std::string& algoName, const HashStats& stats) {
+            if (!stats.hist) return;
+            for (int op = 0; op < HIST_OP_COUNT; ++op) {
+                const LogHistogram& lat = stats.hist->latency[op];
+                const LogHistogram& pr = stats.hist->probes[op];
+                if (lat.count() == 0) continue;
+                std::cout << std::left << std::setw(25) << algoName
+                    << std::setw(13) << HIST_OP_NAMES[op]
+                    << std::setw(10) << lat.count()
+                    << std::setw(10) << lat.percentile(50)
+                    << std::setw(10) << lat.percentile(99)
+                    << std::setw(10) << lat.percentile(99.9)
+                    << std::setw(12) << lat.max()
+                    << std::setw(10) << pr.percentile(50)
+                    << std::setw(10) << pr.percentile(99)
+                    << std::setw(10) << pr.percentile(99.9)
+                    << std::setw(10) << pr.max()
+                    << '\n';
+            }
+        }
+    }
+
+    // Chạy đủ insert / search HIT / search MISS / erase trên bảng đã bật histogram,
+    // in phân vị độ trễ và số probe của từng loại thao tác
+    template <typename Table>
+    void runPercentileRow(const std::string& algoName, Table& table, const Workload& w) {
+        table.stats.enableHistograms();
+        int val;
+        for (const auto& kv : w.keyvals)
+            table.insert(kv.first, kv.second);
+        for (int idx : w.search_hit_indices)
+            table.search(w.keyvals[idx].first, val);
+        for (int key : w.search_miss_keys)
+            table.search(key, val);
+        for (int idx : w.delete_indices)
+            table.erase(w.keyvals[idx].first);
+        printOutput::printHistogramStats(algoName, table.stats);
+    }
+
+    void runPercentileExperiment(int M, double lf, double miss_rate) {
+        std::cout << "\n=== PER-OPERATION PERCENTILES: LATENCY (ns) AND PROBES, LF = " << helper::doubleToStr(lf) << " ===\n";
+        printOutput::printHistogramHeader();
+
+        int N = helper::nextPrime(int(M / lf));
+        Workload w = makeWorkload(1, M, miss_rate, N * 10);
+
+        DoubleHashTable<int, int> dht(N);
+        runPercentileRow("Double Hashing", dht, w);
+        LinearHashTable<int, int> lpt(N);
+        runPercentileRow("Linear Probing", lpt, w);
+        QuadraticHashTable<int, int> qpt(N);
+        runPercentileRow("Quadratic Probing", qpt, w);
+        GroupDoubleHashTable<int, int> gdt(N);
+        runPercentileRow("Group Double SIMD", gdt, w);
+        RobinHoodHashTable<int, int> rht(N);
+        runPercentileRow("Robin Hood Double", rht, w);
+        CuckooHashTable<int, int> ckt(N);
+        runPercentileRow("Bucketized Cuckoo", ckt, w);
+        HopscotchHashTable<int, int> hst(N);
+        runPercentileRow("Hopscotch", hst, w);
+        BucketDoubleHashTable<int, int> bdt(N);
+        runPercentileRow("Bucketized Double", bdt, w);
+        DynamicDoubleHashTable<int, int> ddt(17);
+        runPercentileRow("Dynamic Double", ddt, w);
+        DynamicDoubleHashTable<int, int> dit(17, true);
+        runPercentileRow("Dynamic Double (Incr)", dit, w);
+    }
+
+    // ======= Chế độ dòng lệnh =======
+    // Chạy không tương tác, tham số lấy từ flag, kết quả in dạng CSV hoặc JSON để script
+    // quét tham số và so sánh giữa các bản build
+    namespace cli {
+        struct Options {
+            int size = 0;
+            std::vector<double> loadFactors = { 0.7, 0.5 };
+            double missRate = 0.5;
+            std::vector<int> patterns = { 1, 2, 3 };
+            std::vector<std::string> algorithms;  // rỗng = tất cả
+            uint64_t seed = generator::DEFAULT_SEED;
+            measure::Config measure;
+            int pinCpu = -1;  // -1: core đầu tiên được phép, -2: không ghim
+            bool histograms = false;
+            std::string format = "csv";
+        };
+
+        struct RunResult {
+            StatResult stat;
+            HashStats stats;
+            int tableSize;
+        };
+
+        // Một thuật toán trong registry: tên dùng trên dòng lệnh, nhãn hiển thị, hàm đo
+        struct Algorithm {
+            std::string name;
+            std::string label;
+            std::function<RunResult(int, const Workload&, const measure::Config&, bool)> run;
+        };
+
+        template <typename Table>
+        Algorithm makeAlgorithm(const std::string& name, const std::string& label) {
+            return { name, label, [](int n, const Workload& w, const measure::Config& cfg, bool histograms) {
+                Table table(n);
+                if constexpr (decltype(table.stats)::HISTOGRAMS) {
+                    if (histograms) table.stats.enableHistograms();
+                }
+                RunResult r;
+                r.stat = testTable(table, w.keyvals, w.search_hit_indices, w.search_miss_keys, w.delete_indices, cfg);
+                r.stats = table.stats.snapshot();
+                r.tableSize = table.size();
+                return r;
+            } };
+        }
+
+        const std::vector<Algorithm>& registry() {
+            static const std::vector<Algorithm> algorithms = {
+                makeAlgorithm<DoubleHashTable<int, int>>("double", "Double Hashing"),
+                makeAlgorithm<LinearHashTable<int, int>>("linear", "Linear Probing"),
+                makeAlgorithm<QuadraticHashTable<int, int>>("quadratic", "Quadratic Probing"),
+                makeAlgorithm<GroupDoubleHashTable<int, int>>("group", "Group Double SIMD"),
+                makeAlgorithm<RobinHoodHashTable<int, int>>("robinhood", "Robin Hood Double"),
+                makeAlgorithm<CuckooHashTable<int, int>>("cuckoo", "Bucketized Cuckoo"),
+                makeAlgorithm<HopscotchHashTable<int, int>>("hopscotch", "Hopscotch"),
+                makeAlgorithm<BucketDoubleHashTable<int, int>>("bucket-double", "Bucketized Double"),
+                makeAlgorithm<DoubleHashTable<int, int, SoASlots>>("soa", "Double Hash (SoA)"),
+                makeAlgorithm<DoubleHashTable<int, int, AoSSlots, Pow2Sizing>>("pow2", "Double Hash (Pow2)"),
+                makeAlgorithm<DoubleHashTable<int, int, AoSSlots, PrimeSizing, HashUtils::MixHash<int>, NoStats>>("double-nostats", "Double Hashing (No Stats)"),
+                makeAlgorithm<DoubleHashTable<int, int, AoSSlots, PrimeSizing, HashUtils::MixHash<int>, ShardedStats>>("double-sharded-stats", "Double Hashing (Sharded Stats)"),
+            };
+            return algorithms;
+        }
+
+        void printUsage(const char* prog) {
+            std::cerr << "Usage: " << prog << " [options]   (no options: interactive mode)\n"
+                << "  --size N               number of keys (required)\n"
+                << "  --lf A[,B...]          load factors (default 0.7,0.5)\n"
+                << "  --miss-rate R          search miss rate in [0,1] (default 0.5)\n"
+                << "  --patterns P[,...]     random,sequential,clustered (default all)\n"
+                << "  --algorithms A[,...]   ";
+            for (size_t i = 0; i < registry().size(); ++i)
+                std::cerr << (i ? "," : "") << registry()[i].name;
+            std::cerr << " (default all)\n"
+                << "  --seed S               random seed (default " << generator::DEFAULT_SEED << ")\n"
+                << "  --reps R               minimum measured repetitions (default 5)\n"
+                << "  --max-reps R           stop repeating after R runs (default 30)\n"
+                << "  --warmup W             unmeasured warmup runs (default 1)\n"
+                << "  --ci P                 stop once the 95% CI is within P% of the mean (default 2)\n"
+                << "  --pin CPU|none         pin to a core (default: first allowed core)\n"
+                << "  --histograms           record per-operation latency/probe percentiles (slows timed phases)\n"
+                << "  --format csv|json      output format (default csv)\n";
+        }
+
+        std::vector<std::string> splitList(const std::string& s) {
+            std::vector<std::string> items;
+            std::stringstream ss(s);
+            std::string item;
+            while (std::getline(ss, item, ','))
+                if (!item.empty()) items.push_back(item);
+            return items;
+        }
+
+        // Trả về false và ghi lý do vào error nếu tham số không hợp lệ
+        bool parseArgs(int argc, char** argv, Options& opts, std::string& error) {
+            for (int i = 1; i < argc; ++i) {
+                std::string flag = argv[i];
+                std::string value;
+                size_t eq = flag.find('=');
+                if (eq != std::string::npos) {
+                    value = flag.substr(eq + 1);
+                    flag = flag.substr(0, eq);
+                }
+                else if (flag != "--help" && flag != "--histograms") {
+                    if (i + 1 >= argc) {
+                        error = "missing value for " + flag;
+                        return false;
+                    }
+                    value = argv[++i];
+                }
+
+                try {
+                    if (flag == "--help") {
+                        error.clear();
+                        return false;
+                    }
+                    else if (flag == "--histograms") opts.histograms = true;
+                    else if (flag == "--size") opts.size = std::stoi(value);
+                    else if (flag == "--miss-rate") opts.missRate = std::stod(value);
+                    else if (flag == "--seed") opts.seed = std::stoull(value);
+                    else if (flag == "--reps") opts.measure.minReps = std::stoi(value);
+                    else if (flag == "--max-reps") opts.measure.maxReps = std::stoi(value);
+                    else if (flag == "--warmup") opts.measure.warmup = std::stoi(value);
+                    else if (flag == "--ci") opts.measure.targetRelCI = std::stod(value) / 100;
+                    else if (flag == "--pin") opts.pinCpu = value == "none" ? -2 : std::stoi(value);
+                    else if (flag == "--format") opts.format = value;
+                    else if (flag == "--lf") {
+                        opts.loadFactors.clear();
+                        for (const auto& item : splitList(value))
+                            opts.loadFactors.push_back(std::stod(item));
+                    }
+                    else if (flag == "--patterns") {
+                        opts.patterns.clear();
+                        for (auto item : splitList(value)) {
+                            std::transform(item.begin(), item.end(), item.begin(), ::toupper);
+                            auto it = std::find(std::begin(PATTERN_NAMES), std::end(PATTERN_NAMES), item);
+                            if (it == std::end(PATTERN_NAMES)) {
+                                error = "unknown pattern: " + item;
+                                return false;
+                            }
+                            opts.patterns.push_back(int(it - std::begin(PATTERN_NAMES)) + 1);
+                        }
+                    }
+                    else if (flag == "--algorithms") {
+                        opts.algorithms = splitList(value);
+                        for (const auto& name : opts.algorithms) {
+                            bool known = std::any_of(registry().begin(), registry().end(), [&](const Algorithm& a) { return a.name == name; });
+                            if (!known) {
+                                error = "unknown algorithm: " + name;
+                                return false;
+                            }
+                        }
+                    }
+                    else {
+                        error = "unknown option: " + flag;
+                        return false;
+                    }
+                }
+                catch (const std::exception&) {
+                    error = "invalid value for " + flag + ": " + value;
+                    return false;
+                }
+            }
+
+            if (opts.size <= 0) error = "--size must be a positive integer";
+            else if (opts.loadFactors.empty()) error = "--lf needs at least one load factor";
+            else if (std::any_of(opts.loadFactors.begin(), opts.loadFactors.end(), [](double lf) { return lf <= 0 || lf > 1; }))
+                error = "load factors must be in (0, 1]";
+            else if (opts.missRate < 0 || opts.missRate > 1) error = "--miss-rate must be in [0, 1]";
+            else if (opts.patterns.empty()) error = "--patterns needs at least one pattern";
+            else if (opts.measure.minReps < 1) error = "--reps must be >= 1";
+            else if (opts.measure.maxReps < opts.measure.minReps) error = "--max-reps must be >= --reps";
+            else if (opts.measure.warmup < 0) error = "--warmup must be >= 0";
+            else if (opts.measure.targetRelCI < 0) error = "--ci must be >= 0";
+            else if (opts.pinCpu < -2) error = "--pin must be a core index or none";
+            else if (opts.format != "csv" && opts.format != "json") error = "--format must be csv or json";
+            return error.empty();
+        }
+
+        // Một cột kết quả; quoted = chuỗi (JSON cần dấu nháy)
+        struct Field {
+            std::string name;
+            std::string value;
+            bool quoted;
+        };
+
+        template <typename T>
+        std::string num(T v) {
+            std::ostringstream oss;
+            oss << std::setprecision(10) << v;
+            return oss.str();
+        }
+
+        // In từng bản ghi: CSV (header ở bản ghi đầu) hoặc một mảng JSON
+        class RecordWriter {
+            bool json;
+            bool first = true;
+
+        public:
+            explicit RecordWriter(bool json) : json(json) {
+                if (json) std::cout << "[\n";
+            }
+
+            void write(const std::vector<Field>& fields) {
+                if (json) {
+                    std::cout << (first ? "" : ",\n") << "  {";
+                    for (size_t i = 0; i < fields.size(); ++i) {
+                        const Field& f = fields[i];
+                        std::cout << (i ? ", " : "") << '"' << f.name << "\": ";
+                        if (f.quoted) std::cout << '"' << f.value << '"';
+                        else std::cout << f.value;
+                    }
+                    std::cout << "}";
+                }
+                else {
+                    if (first) {
+                        for (size_t i = 0; i < fields.size(); ++i)
+                            std::cout << (i ? "," : "") << fields[i].name;
+                        std::cout << '\n';
+                    }
+                    for (size_t i = 0; i < fields.size(); ++i)
+                        std::cout << (i ? "," : "") << fields[i].value;
+                    std::cout << '\n';
+                }
+                std::cout.flush();
+                first = false;
+            }
+
+            void finish() {
+                if (json) std::cout << (first ? "]\n" : "\n]\n");
+            }
+        };
+
+        std::vector<Field> resultFields(const Options& opts, const std::string& pattern, const Algorithm& algo, double lf, const RunResult& r) {
+            std::vector<Field> fields = {
+                { "pattern", pattern, true },
+                { "algorithm", algo.name, true },
+                { "label", algo.label, true },
+                { "load_factor", num(lf), false },
+                { "size", num(opts.size), false },
+                { "table_size", num(r.tableSize), false },
+                { "miss_rate", num(opts.missRate), false },
+                { "seed", num(opts.seed), false },
+                { "runs", num(r.stat.runs), false },
+                { "insert_us", num(r.stat.insertTime), false },
+                { "search_us", num(r.stat.searchTime), false },
+                { "delete_us", num(r.stat.deleteTime), false },
+                { "batch_search_us", num(r.stat.batchSearchTime), false },
+                { "insert_after_delete_us", num(r.stat.insertAfterDeleteTime), false },
+                { "avg_probe_search_hit", num(r.stat.avgProbeSearchHit), false },
+                { "avg_probe_search_miss", num(r.stat.avgProbeSearchMiss), false },
+                { "avg_probe_insert_after_delete", num(r.stat.avgProbeInsertAfterDelete), false },
+                { "avg_probe_search_miss_after_churn", num(r.stat.avgProbeSearchMissAfterChurn), false },
+                { "total_probes_insert", num(r.stats.totalProbesInsert), false },
+                { "total_probes_search", num(r.stats.totalProbesSearch), false },
+                { "total_probes_delete", num(r.stats.totalProbesDelete), false },
+                { "total_collision", num(r.stats.totalCollision), false },
+                { "n_insert", num(r.stats.nInsert), false },
+                { "n_search", num(r.stats.nSearch), false },
+                { "n_delete", num(r.stats.nDelete), false },
+                { "n_compact", num(r.stats.nCompact), false },
+                { "n_resize", num(r.stats.nResize), false },
+            };
+
+            // Mỗi pha: median/min/stddev quy về ns/op và độ rộng khoảng tin cậy (% mean)
+            auto addPhase = [&](const std::string& name, const PhaseStats& ps) {
+                auto perOp = [&](double ns) { return num(ps.ops > 0 ? ns / ps.ops : 0); };
+                fields.push_back({ name + "_ns_op", num(ps.nsPerOp), false });
+                fields.push_back({ name + "_min_ns_op", perOp(ps.minNs), false });
+                fields.push_back({ name + "_stddev_ns_op", perOp(ps.stddevNs), false });
+                fields.push_back({ name + "_ci95_pct", num(100 * ps.relCI()), false });
+                for (int e = 0; e < PERF_EVENT_COUNT; ++e)
+                    fields.push_back({ name + "_" + PERF_EVENT_NAMES[e] + "_op", num(ps.perf.perOp(e)), false });
+            };
+            addPhase("insert", r.stat.insertPhase);
+            addPhase("search_hit", r.stat.searchHitPhase);
+            addPhase("search_miss", r.stat.searchMissPhase);
+            addPhase("delete", r.stat.deletePhase);
+            addPhase("insert_after_delete", r.stat.insertAfterDeletePhase);
+            addPhase("batch_search", r.stat.batchSearchPhase);
+
+            if (r.stats.hist) {
+                for (int op = 0; op < HIST_OP_COUNT; ++op) {
+                    const LogHistogram& lat = r.stats.hist->latency[op];
+                    const LogHistogram& pr = r.stats.hist->probes[op];
+                    std::string name = HIST_OP_NAMES[op];
+                    fields.push_back({ name + "_count", num(lat.count()), false });
+                    fields.push_back({ name + "_lat_p50_ns", num(lat.percentile(50)), false });
+                    fields.push_back({ name + "_lat_p99_ns", num(lat.percentile(99)), false });
+                    fields.push_back({ name + "_lat_p999_ns", num(lat.percentile(99.9)), false });
+                    fields.push_back({ name + "_lat_max_ns", num(lat.max()), false });
+                    fields.push_back({ name + "_probes_p50", num(pr.percentile(50)), false });
+                    fields.push_back({ name + "_probes_p99", num(pr.percentile(99)), false });
+                    fields.push_back({ name + "_probes_p999", num(pr.percentile(99.9)), false });
+                    fields.push_back({ name + "_probes_max", num(pr.max()), false });
+                }
+            }
+            return fields;
+        }
+
+        int run(int argc, char** argv) {
+            Options opts;
+            std::string error;
+            if (!parseArgs(argc, argv, opts, error)) {
+                if (!error.empty()) std::cerr << "error: " << error << "\n";
+                printUsage(argv[0]);
+                return error.empty() ? 0 : 2;
+            }
+            generator::setSeed(opts.seed);
+            if (opts.pinCpu != -2 && !measure::pinToCore(opts.pinCpu))
+                std::cerr << "warning: could not pin to a core, timings may be noisier\n";
+
+            std::vector<const Algorithm*> selected;
+            for (const auto& algo : registry())
+                if (opts.algorithms.empty() || std::find(opts.algorithms.begin(), opts.algorithms.end(), algo.name) != opts.algorithms.end())
+                    selected.push_back(&algo);
+
+            int maxN = 0;
+            for (double lf : opts.loadFactors)
+                maxN = std::max(maxN, helper::nextPrime(int(opts.size / lf)));
+
+            RecordWriter writer(opts.format == "json");
+            for (int pattern : opts.patterns) {
+                Workload w = makeWorkload(pattern, opts.size, opts.missRate, maxN * 10);
+                for (double lf : opts.loadFactors) {
+                    int N = helper::nextPrime(int(opts.size / lf));
+                    for (const Algorithm* algo : selected) {
+                        writer.write(resultFields(opts, w.patternName, *algo, lf, algo->run(N, w, opts.measure, opts.histograms)));
+                    }
+                }
+            }
+            writer.finish();
+            return 0;
+        }
     }
 }
 
-int main(void) {
+#ifndef DOUBLE_HASHING_NO_MAIN
+int main(int argc, char** argv) {
+    // Có tham số dòng lệnh: chạy không tương tác
+    if (argc > 1)
+        return BenchmarkUtils::cli::run(argc, argv);
+
+    // Ghim vào một core để số đo ổn định hơn
+    BenchmarkUtils::measure::pinToCore();
+
     // Nhập đầu vào chung
     int M = BenchmarkUtils::getInput::getTestSize();
     double lf1 = BenchmarkUtils::getInput::getUserLoadFactor();
@@ -1284,62 +5111,37 @@ int main(void) {
     int N2 = helper::nextPrime(int(M / lf2));
     BenchmarkUtils::printOutput::printTableSizes(lf1, lf2, N1, N2);
 
-    // Nhập miss rate và số delete chỉ 1 lần
+    // Nhập miss rate chỉ 1 lần
 	double miss_rate = BenchmarkUtils::getInput::getMissRate(); 
 
-    int num_delete = M;
-
     // Lặp qua cả 3 kiểu dữ liệu
     for (int datatype = 1; datatype <= 3; ++datatype) {
-        std::string patternName;
-        if (datatype == 1) patternName = "RANDOM";
-        else if (datatype == 2) patternName = "SEQUENTIAL";
-        else patternName = "CLUSTERED";
+        std::string patternName = BenchmarkUtils::PATTERN_NAMES[datatype - 1];
 
         std::cout << "\n===============================\n";
         std::cout << ">>> DATA PATTERN: " << patternName << "\n";
 
-        // Tạo key-value tương ứng
-        std::vector<std::pair<int, int>> keyvals;
-        if (datatype == 1)
-            keyvals = BenchmarkUtils::generator::generateRandomKeyVals(M, std::max(N1, N2) * 10);
-        else if (datatype == 2)
-            keyvals = BenchmarkUtils::generator::generateSequentialKeyVals(M);
-        else
-            keyvals = BenchmarkUtils::generator::generateClusteredKeyVals(M, std::max(N1, N2) * 10);
-
-        // Sinh chỉ số search hit/miss
-        std::vector<int> all_indices(M);
-        helper::iota(all_indices.begin(), all_indices.end(), 0);
-
-        int num_search = M;
-        int num_miss = int(num_search * miss_rate + 0.5);
-        int num_hit = num_search - num_miss;
-
-        // Hit indices
-        std::vector<int> indices = all_indices;
-        shuffle(indices.begin(), indices.end(), std::mt19937(std::chrono::steady_clock::now().time_since_epoch().count()));
-        std::vector<int> search_hit_indices(indices.begin(), indices.begin() + num_hit);
-
-        // Miss keys
-        std::unordered_set<int> exist_keys;
-        for (const auto& kv : keyvals) exist_keys.insert(kv.first);
-		std::vector<int> search_miss_keys = BenchmarkUtils::generator::generateMissKeys(num_miss, exist_keys, std::max(N1, N2) * 10);
-
-        // Delete indices
-        std::vector<int> delete_indices = all_indices;
-        std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
-        shuffle(delete_indices.begin(), delete_indices.end(), rng);
-        delete_indices.resize(num_delete);
+        BenchmarkUtils::Workload workload = BenchmarkUtils::makeWorkload(datatype, M, miss_rate, std::max(N1, N2) * 10);
+        const auto& keyvals = workload.keyvals;
+        const auto& search_hit_indices = workload.search_hit_indices;
+        const auto& search_miss_keys = workload.search_miss_keys;
+        const auto& delete_indices = workload.delete_indices;
 
         // Tạo bảng băm cho 2 cấu hình LF1 và LF2
         DoubleHashTable<int, int> dht1(N1), dht2(N2);
         LinearHashTable<int, int> lpt1(N1), lpt2(N2);
         QuadraticHashTable<int, int> qpt1(N1), qpt2(N2);
+        GroupDoubleHashTable<int, int> gdt1(N1), gdt2(N2);
+        DoubleHashTable<int, int, SoASlots> sdt1(N1), sdt2(N2);
+        DoubleHashTable<int, int, AoSSlots, Pow2Sizing> pdt1(N1), pdt2(N2);
+        RobinHoodHashTable<int, int> rht1(N1), rht2(N2);
+        CuckooHashTable<int, int> ckt1(N1), ckt2(N2);
+        HopscotchHashTable<int, int> hst1(N1), hst2(N2);
+        BucketDoubleHashTable<int, int> bdt1(N1), bdt2(N2);
 
         // Thống kê cluster
-        BenchmarkUtils::insertAndPrintClusterStats(dht1, lpt1, qpt1, keyvals, "After Insert with LF1");
-        BenchmarkUtils::insertAndPrintClusterStats(dht2, lpt2, qpt2, keyvals, "After Insert with LF2");
+        BenchmarkUtils::insertAndPrintClusterStats(dht1, lpt1, qpt1, hst1, keyvals, "After Insert with LF1");
+        BenchmarkUtils::insertAndPrintClusterStats(dht2, lpt2, qpt2, hst2, keyvals, "After Insert with LF2");
 
         // Đo hiệu năng
         auto dht1_stat = BenchmarkUtils::testTable(dht1, keyvals, search_hit_indices, search_miss_keys, delete_indices);
@@ -1348,26 +5150,71 @@ int main(void) {
         auto lpt2_stat = BenchmarkUtils::testTable(lpt2, keyvals, search_hit_indices, search_miss_keys, delete_indices);
         auto qpt1_stat = BenchmarkUtils::testTable(qpt1, keyvals, search_hit_indices, search_miss_keys, delete_indices);
         auto qpt2_stat = BenchmarkUtils::testTable(qpt2, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto gdt1_stat = BenchmarkUtils::testTable(gdt1, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto gdt2_stat = BenchmarkUtils::testTable(gdt2, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto sdt1_stat = BenchmarkUtils::testTable(sdt1, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto sdt2_stat = BenchmarkUtils::testTable(sdt2, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto pdt1_stat = BenchmarkUtils::testTable(pdt1, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto pdt2_stat = BenchmarkUtils::testTable(pdt2, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto rht1_stat = BenchmarkUtils::testTable(rht1, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto rht2_stat = BenchmarkUtils::testTable(rht2, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto ckt1_stat = BenchmarkUtils::testTable(ckt1, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto ckt2_stat = BenchmarkUtils::testTable(ckt2, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto hst1_stat = BenchmarkUtils::testTable(hst1, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto hst2_stat = BenchmarkUtils::testTable(hst2, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto bdt1_stat = BenchmarkUtils::testTable(bdt1, keyvals, search_hit_indices, search_miss_keys, delete_indices);
+        auto bdt2_stat = BenchmarkUtils::testTable(bdt2, keyvals, search_hit_indices, search_miss_keys, delete_indices);
 
         // In bảng thống kê hiệu năng
-        BenchmarkUtils::printOutput::printSummaryTable(lf1, lf2, dht1_stat, dht2_stat, lpt1_stat, lpt2_stat, qpt1_stat, qpt2_stat);
+        BenchmarkUtils::printOutput::printSummaryTable(lf1, lf2, {
+            { "Double Hashing", dht1_stat, dht2_stat },
+            { "Linear Probing", lpt1_stat, lpt2_stat },
+            { "Quadratic Probing", qpt1_stat, qpt2_stat },
+            { "Group Double SIMD", gdt1_stat, gdt2_stat },
+            { "Double Hash (SoA)", sdt1_stat, sdt2_stat },
+            { "Double Hash (Pow2)", pdt1_stat, pdt2_stat },
+            { "Robin Hood Double", rht1_stat, rht2_stat },
+            { "Bucketized Cuckoo", ckt1_stat, ckt2_stat },
+            { "Hopscotch", hst1_stat, hst2_stat },
+            { "Bucketized Double", bdt1_stat, bdt2_stat },
+        });
 
         std::cout << "\n===== SUMMARY TABLE: PROBES, COLLISIONS, RATES =====\n";
         BenchmarkUtils::printOutput::printDetailHeader();
         BenchmarkUtils::printOutput::printDetailStats("DoubleHash-LF1", lf1, dht1);
         BenchmarkUtils::printOutput::printDetailStats("LinearProb-LF1", lf1, lpt1);
         BenchmarkUtils::printOutput::printDetailStats("QuadraticProb-LF1", lf1, qpt1);
+        BenchmarkUtils::printOutput::printDetailStats("GroupDouble-LF1", lf1, gdt1);
+        BenchmarkUtils::printOutput::printDetailStats("DoubleHashSoA-LF1", lf1, sdt1);
+        BenchmarkUtils::printOutput::printDetailStats("DoubleHashPow2-LF1", lf1, pdt1);
+        BenchmarkUtils::printOutput::printDetailStats("RobinHood-LF1", lf1, rht1);
+        BenchmarkUtils::printOutput::printDetailStats("Cuckoo-LF1", lf1, ckt1);
+        BenchmarkUtils::printOutput::printDetailStats("Hopscotch-LF1", lf1, hst1);
+        BenchmarkUtils::printOutput::printDetailStats("BucketDouble-LF1", lf1, bdt1);
         BenchmarkUtils::printOutput::printDetailStats("DoubleHash-LF2", lf2, dht2);
         BenchmarkUtils::printOutput::printDetailStats("LinearProb-LF2", lf2, lpt2);
         BenchmarkUtils::printOutput::printDetailStats("QuadraticProb-LF2", lf2, qpt2);
+        BenchmarkUtils::printOutput::printDetailStats("GroupDouble-LF2", lf2, gdt2);
+        BenchmarkUtils::printOutput::printDetailStats("DoubleHashSoA-LF2", lf2, sdt2);
+        BenchmarkUtils::printOutput::printDetailStats("DoubleHashPow2-LF2", lf2, pdt2);
+        BenchmarkUtils::printOutput::printDetailStats("RobinHood-LF2", lf2, rht2);
+        BenchmarkUtils::printOutput::printDetailStats("Cuckoo-LF2", lf2, ckt2);
+        BenchmarkUtils::printOutput::printDetailStats("Hopscotch-LF2", lf2, hst2);
+        BenchmarkUtils::printOutput::printDetailStats("BucketDouble-LF2", lf2, bdt2);
         std::cout << "\n";
     }
 
     std::cout << "\n=== FINISHED ALL DATA PATTERNS ===\n";
 
-    BenchmarkUtils::runDynamicInsertExperiment(M);
+    BenchmarkUtils::runDynamicInsertExperiment(M, miss_rate);
+    BenchmarkUtils::runInsertLatencyExperiment(M);
+    BenchmarkUtils::runPercentileExperiment(M, lf1, miss_rate);
+    BenchmarkUtils::runInterleavedLookupExperiment(M, lf1, miss_rate);
+    BenchmarkUtils::runConcurrentResizeExperiment(M);
+    BenchmarkUtils::runScalingExperiment(M);
 
 	std::cout << "\n=== FINISHED DYNAMIC INSERT EXPERIMENT ===\n";
 
     return 0;
 }
+#endif
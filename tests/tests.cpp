@@ -1,6 +1,12 @@
 ﻿#include <cassert>
 #include <iostream>
-#include "main.cpp"  
+#include <string>
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <shared_mutex>
+#define DOUBLE_HASHING_NO_MAIN
+#include "main.cpp"
 
 void testDoubleHashTable() {
     DoubleHashTable<int, int> table(11);
@@ -53,11 +59,1137 @@ void testQuadraticHashTable() {
     assert(table.search(16, val));
 }
 
+void testSoADoubleHashTable() {
+    DoubleHashTable<int, int, SoASlots> table(11);
+    assert(table.insert(5, 100));
+    assert(table.insert(16, 200));
+
+    int val;
+    assert(table.search(16, val));
+    assert(val == 200);
+
+    table.erase(5);
+    assert(!table.search(5, val));
+    assert(table.search(16, val));
+
+    DynamicDoubleHashTable<int, int, SoASlots> dyn(7);
+    for (int i = 0; i < 100; ++i)
+        assert(dyn.insert(i, i * 10));
+    for (int i = 0; i < 100; ++i) {
+        assert(dyn.search(i, val));
+        assert(val == i * 10);
+    }
+    assert(dyn.maxClusterLength() > 0);
+}
+
+void testGroupDoubleHashTable() {
+    GroupDoubleHashTable<int, int> table(64);
+    // Số nhóm lấy từ PrimeLadder
+    assert(table.size() % GroupCtrl::Matcher::WIDTH == 0);
+    assert(PrimeLadder::find(table.size() / GroupCtrl::Matcher::WIDTH) != nullptr);
+    assert(table.hash1(5) == table.groupOf(HashUtils::MixHash<int>{}(5)));
+    // n gần INT_MAX: số nhóm bị chặn để TABLE_SIZE vẫn vừa int
+    using Group = GroupDoubleHashTable<int, int>;
+    assert(1LL * Group::groupRung(std::numeric_limits<int>::max()).size * GroupCtrl::Matcher::WIDTH <= std::numeric_limits<int>::max());
+    assert(Group::groupRung(64).size == table.size() / GroupCtrl::Matcher::WIDTH);
+    for (int i = 0; i < 60; ++i)
+        assert(table.insert(i, i + 1));
+    assert(table.insert(7, 700)); // cập nhật key đã có
+
+    int val;
+    assert(table.search(7, val));
+    assert(val == 700);
+    assert(!table.search(1000, val));
+
+    table.erase(7);
+    assert(!table.search(7, val));
+    assert(table.search(8, val));
+    assert(table.insert(7, 70));
+    assert(table.search(7, val));
+    assert(val == 70);
+}
+
+// Mọi tổ hợp probe / growth / layout dùng chung một lõi: tổ hợp mới (linear + SoA + Pow2,
+// quadratic động rehash tăng dần) có đủ API batch, interleaved và migration
+template<typename Table>
+void checkOpenAddressTable(Table& table, int n) {
+    std::vector<int> keys, values;
+    for (int i = 0; i < n; ++i) {
+        keys.push_back(i * 5);
+        values.push_back(i);
+    }
+    assert(table.insert_batch(keys, values) == n);
+    for (int i = 0; i < n; i += 3)
+        table.erase(i * 5);
+
+    std::vector<int> queries = keys;
+    queries.push_back(-1);
+    std::vector<int> out;
+    std::vector<bool> found;
+    table.search_batch(queries, out, found);
+    for (int i = 0; i < n; ++i) {
+        assert(found[i] == (i % 3 != 0));
+        if (found[i]) assert(out[i] == i);
+    }
+    assert(!found[n]);
+    std::vector<int> out2;
+    std::vector<bool> found2;
+    table.search_interleaved(queries, out2, found2);
+    assert(found2 == found);
+}
+
+void testOpenAddressPolicies() {
+    using LinearSoAPow2 = OpenAddressTable<int, int, LinearProbe, FixedCapacity, HashStats, SoASlots, Pow2Sizing>;
+    LinearSoAPow2 lsp(300);
+    assert(lsp.size() == 512);
+    checkOpenAddressTable(lsp, 300);
+
+    using IncrementalQuadratic = OpenAddressTable<int, int, QuadraticProbe, LoadFactorGrowth>;
+    IncrementalQuadratic iq(17, true);
+    bool sawMigration = false;
+    for (int i = 0; i < 1000; ++i) {
+        assert(iq.insert(i, i));
+        sawMigration = sawMigration || iq.isMigrating();
+    }
+    assert(sawMigration);
+    int val;
+    for (int i = 0; i < 1000; ++i)
+        assert(iq.search(i, val) && val == i);
+
+    DynamicLinearHashTable<int, int> dlt(17);
+    checkOpenAddressTable(dlt, 500);
+    assert(dlt.loadFactor() <= LoadFactorGrowth::MAX_LOAD_FACTOR);
+    assert(dlt.stats.nResize > 0);
+
+    // Tên cũ là alias của cùng một lõi
+    static_assert(std::is_same_v<DoubleHashTable<int, int>, OpenAddressTable<int, int, DoubleProbe>>);
+    static_assert(std::is_same_v<DynamicQuadraticHashTable<int, int>, OpenAddressTable<int, int, QuadraticProbe, LoadFactorGrowth>>);
+}
+
+void testRobinHoodHashTable() {
+    RobinHoodHashTable<int, int> table(101);
+    for (int i = 0; i < 90; ++i)
+        assert(table.insert(i * 7, i));
+    assert(table.insert(14, 1400)); // cập nhật key đã có
+
+    int val;
+    for (int i = 0; i < 90; ++i) {
+        assert(table.search(i * 7, val));
+        assert(val == (i == 2 ? 1400 : i));
+    }
+    assert(table.loadFactor() > 0.89);
+
+    // Search MISS dừng sớm: không bao giờ dài hơn dist lớn nhất + 1 ...
+    long long before = table.stats.totalProbesSearch;
+    for (int k = 1; k < 700; k += 7)
+        assert(!table.search(k, val));
+    assert(table.stats.totalProbesSearch - before <= 100LL * (table.maxDistance() + 1));
+    // ... và trung bình ngắn hơn hẳn double hashing ở cùng LF
+    DoubleHashTable<int, int> dht(101);
+    for (int i = 0; i < 90; ++i)
+        dht.insert(i * 7, i);
+    long long dhtBefore = dht.stats.totalProbesSearch;
+    for (int k = 1; k < 700; k += 7)
+        dht.search(k, val);
+    assert(table.stats.totalProbesSearch - before <= dht.stats.totalProbesSearch - dhtBefore);
+
+    // Xóa giữ dist của tombstone: các key nằm sau vẫn tìm được, insert lại dùng được slot cũ
+    for (int i = 0; i < 90; i += 2)
+        table.erase(i * 7);
+    assert(table.stats.nCompact > 0);
+    for (int i = 0; i < 90; ++i)
+        assert(table.search(i * 7, val) == (i % 2 == 1));
+    for (int i = 0; i < 90; i += 2)
+        assert(table.insert(i * 7, -i));
+    for (int i = 0; i < 90; ++i) {
+        assert(table.search(i * 7, val));
+        assert(val == (i % 2 ? i : -i));
+    }
+    assert(table.avgDistance() <= table.maxDistance());
+}
+
+// Value 40 byte: bucket chỉ còn 1 slot nhưng vẫn đúng 64 byte
+struct WideValue {
+    long long parts[5] = {};
+};
+
+// Chỉ BucketDoubleHashTable nhận bucket hẹp, CuckooHashTable đòi MIN_WIDE_SLOTS
+template<typename Table>
+void checkWideBuckets() {
+    static_assert(Table::SLOTS == 1 && sizeof(typename Table::Bucket) == 64);
+    Table table(200);
+    for (long long i = 0; i < 80; ++i) {
+        WideValue v;
+        v.parts[4] = i;
+        assert(table.insert(i, v));
+    }
+    WideValue out;
+    for (long long i = 0; i < 80; ++i)
+        assert(table.search(i, out) && out.parts[4] == i);
+    assert(!table.search(-1, out));
+}
+
+void testCuckooHashTable() {
+    using Table = CuckooHashTable<int, int>;
+    static_assert(sizeof(Table::Bucket) == 64);
+
+    Table table(1000);
+    int n = int(table.size() * 0.95);
+    for (int i = 0; i < n; ++i)
+        assert(table.insert(i, i * 2));
+    assert(table.insert(5, 500)); // cập nhật key đã có
+
+    // Mỗi search chạm tối đa 2 bucket + stash
+    int val;
+    long long before = table.stats.totalProbesSearch;
+    for (int i = 0; i < n; ++i) {
+        assert(table.search(i, val));
+        assert(val == (i == 5 ? 500 : i * 2));
+    }
+    for (int i = n; i < 2 * n; ++i)
+        assert(!table.search(i, val));
+    assert(table.stats.totalProbesSearch - before <= 3LL * 2 * n);
+
+    for (int i = 0; i < n; i += 2)
+        table.erase(i);
+    for (int i = 0; i < n; ++i)
+        assert(table.search(i, val) == (i % 2 == 1));
+
+    std::vector<int> keys = { 1, 3, 5, 7, 1000 };
+    std::vector<int> values;
+    std::vector<bool> found;
+    table.search_batch(keys, values, found);
+    assert(found[0] && found[2] && !found[4]);
+    assert(values[2] == 500);
+
+    // 2 bucket x SLOTS: khi đầy key vào stash, stash đầy thì insert thất bại mà không mất key nào
+    Table tiny(2 * Table::SLOTS);
+    int cap = tiny.size() + Table::STASH_SIZE;
+    for (int i = 0; i < cap; ++i)
+        assert(tiny.insert(i, i));
+    assert(tiny.stashSize() == Table::STASH_SIZE);
+    assert(!tiny.insert(cap, cap));
+    for (int i = 0; i < cap; ++i)
+        assert(tiny.search(i, val) && val == i);
+    // Xóa khỏi bucket kéo key trong stash về
+    tiny.erase(0);
+    tiny.erase(1);
+    assert(tiny.stashSize() == Table::STASH_SIZE - 2);
+    for (int i = 2; i < cap; ++i)
+        assert(tiny.search(i, val) && val == i);
+
+    // Cuckoo chỉ nhận bucket >= 4 slot; cặp 12 byte vừa đúng 4 slot sau padding
+    using Narrow = CuckooHashTable<long long, int>;
+    static_assert(Narrow::SLOTS == Narrow::Bucket::MIN_WIDE_SLOTS && sizeof(Narrow::Bucket) == 64);
+    Narrow narrow(200);
+    for (long long i = 0; i < 150; ++i)
+        assert(narrow.insert(i, int(i)));
+    for (long long i = 0; i < 150; ++i)
+        assert(narrow.search(i, val) && val == i);
+}
+
+void testHopscotchHashTable() {
+    using Table = HopscotchHashTable<int, int>;
+    Table table(1009);
+    int n = int(table.size() * 0.95);
+    int inserted = 0;
+    for (int i = 0; i < n; ++i)
+        inserted += table.insert(i * 3, i);
+    assert(inserted == n);
+    assert(table.insert(6, 600)); // cập nhật key đã có
+    assert(table.loadFactor() > 0.94);
+
+    // Mọi key nằm trong vùng lân cận: search không bao giờ so quá H key
+    int val;
+    long long before = table.stats.totalProbesSearch;
+    for (int i = 0; i < n; ++i) {
+        assert(table.search(i * 3, val));
+        assert(val == (i == 2 ? 600 : i));
+    }
+    for (int i = 0; i < n; ++i)
+        assert(!table.search(i * 3 + 1, val));
+    assert(table.stats.totalProbesSearch - before <= 2LL * n * Table::H);
+    assert(table.maxClusterLength() > 0);
+    assert(table.avgClusterLength() > 0);
+
+    // Xóa không để lại tombstone, slot dùng lại được ngay
+    for (int i = 0; i < n; i += 2)
+        table.erase(i * 3);
+    for (int i = 0; i < n; ++i)
+        assert(table.search(i * 3, val) == (i % 2 == 1));
+    for (int i = 0; i < n; i += 2)
+        assert(table.insert(i * 3, -i));
+    for (int i = 0; i < n; ++i)
+        assert(table.search(i * 3, val) && val == (i % 2 ? i : -i));
+
+    // Bảng nhỏ hơn H: vùng lân cận thu về TABLE_SIZE, vẫn đầy được
+    Table tiny(7);
+    for (int i = 0; i < 7; ++i)
+        assert(tiny.insert(i, i));
+    assert(!tiny.insert(100, 100));
+    for (int i = 0; i < 7; ++i)
+        assert(tiny.search(i, val) && val == i);
+}
+
+void testBucketDoubleHashTable() {
+    using Table = BucketDoubleHashTable<int, int>;
+    static_assert(sizeof(Table::Bucket) == 64);
+
+    Table table(1000);
+    assert(helper::isPrime(table.bucketCount()));
+    int n = int(table.size() * 0.95);
+    for (int i = 0; i < n; ++i)
+        assert(table.insert(i, i + 1));
+    assert(table.insert(9, 900)); // cập nhật key đã có
+    assert(table.maxClusterLength() > 0);
+
+    int val;
+    for (int i = 0; i < n; ++i) {
+        assert(table.search(i, val));
+        assert(val == (i == 9 ? 900 : i + 1));
+    }
+    assert(!table.search(-1, val));
+
+    std::vector<int> keys = { 0, 9, -5 };
+    std::vector<int> values;
+    std::vector<bool> found;
+    table.search_batch(keys, values, found);
+    assert(found[0] && found[1] && !found[2]);
+    assert(values[1] == 900);
+
+    // Erase trả overflow về đúng như cũ: khi bảng rỗng, search MISS chỉ chạm bucket gốc
+    for (int i = 0; i < n; i += 2)
+        table.erase(i);
+    for (int i = 0; i < n; ++i)
+        assert(table.search(i, val) == (i % 2 == 1));
+    for (int i = 1; i < n; i += 2)
+        table.erase(i);
+    assert(table.loadFactor() == 0);
+    long long before = table.stats.totalProbesSearch;
+    for (int i = 0; i < n; ++i)
+        assert(!table.search(i, val));
+    assert(table.stats.totalProbesSearch - before == n);
+
+    // Bảng đầy: insert key mới thất bại, cập nhật key cũ vẫn được
+    Table full(2 * Table::SLOTS);
+    for (int i = 0; i < full.size(); ++i)
+        assert(full.insert(i, i));
+    assert(!full.insert(-1, -1));
+    assert(full.insert(0, 42) && full.search(0, val) && val == 42);
+
+    checkWideBuckets<BucketDoubleHashTable<long long, WideValue>>();
+    static_assert(CacheLineBucket<int, int>::SLOTS == 7);
+    static_assert(CacheLineBucket<long long, long long>::SLOTS == 3);
+
+    // Pow2Sizing tự chọn số bucket lũy thừa của 2, bước nhảy lẻ vẫn đi qua mọi bucket
+    BucketDoubleHashTable<int, int, Pow2Sizing> pow2(1000);
+    assert(std::has_single_bit(unsigned(pow2.bucketCount())));
+    for (int i = 0; i < pow2.size(); ++i)
+        assert(pow2.insert(i, i));
+    assert(pow2.isFull());
+    for (int i = 0; i < pow2.size(); ++i)
+        assert(pow2.search(i, val) && val == i);
+}
+
+void testFastMod() {
+    std::mt19937 rng(12345);
+    const uint32_t divisors[] = { 1, 2, 3, 7, 11, 101, 65537, 1000003, 2147483647u, 4294967291u };
+    for (uint32_t d : divisors) {
+        helper::FastMod fm(d);
+        for (int i = 0; i < 10000; ++i) {
+            uint32_t a = rng();
+            assert(fm.mod(a) == a % d);
+        }
+        assert(fm.mod(0) == 0);
+        assert(fm.mod(UINT32_MAX) == UINT32_MAX % d);
+    }
+    assert(helper::addMod(5, 6, 11) == 0);
+    assert(helper::addMod(5, 5, 11) == 10);
+}
+
+void testPrimeLadder() {
+    assert(PrimeLadder::atLeast(18).size == 19);
+    assert(PrimeLadder::atLeast(2 * 19).size == 41);
+    for (int i = 0; i < PrimeLadder::NUM_RUNGS; ++i) {
+        const auto& rung = PrimeLadder::RUNGS[i];
+        assert(rung.prime == helper::prevPrime(rung.size));
+        assert(rung.modSize.mod(123456789u) == 123456789u % rung.size);
+    }
+    // Kích thước tĩnh ngoài bảng: giữ n slot, PRIME lấy từ bảng chứ không tìm lại
+    assert(PrimeLadder::primeBelow(211) == 167);
+    assert(PrimeLadder::primeBelow(3) == 2 && PrimeLadder::primeBelow(2) == 1);
+    PrimeSizing fixed;
+    fixed.init(211);
+    assert(fixed.TABLE_SIZE == 211 && fixed.PRIME == 167);
+    fixed.init(337);
+    assert(fixed.TABLE_SIZE == 337 && fixed.PRIME == 331);
+    assert(fixed.fullCycle());
+    // Kích thước hợp số: bước nhảy có thể chung ước với n nên dãy probe không phủ hết bảng
+    fixed.init(60);
+    assert(fixed.TABLE_SIZE == 60 && !fixed.fullCycle());
+    fixed.init(211);
+    assert(fixed.fullCycle());
+    // Bậc cuối: probe + offset vượt INT_MAX nhưng phép cộng vòng vẫn đúng
+    const auto& top = PrimeLadder::RUNGS[PrimeLadder::NUM_RUNGS - 1];
+    assert(helper::addMod(top.size - 1, top.prime, top.size) == top.prime - 1);
+    PrimeSizing sz;
+    assert(sz.grow(top.size) && sz.TABLE_SIZE == top.size);
+    assert(!sz.grow(2LL * top.size) && sz.TABLE_SIZE == PrimeSizing::MAX_TABLE_SIZE);
+
+    DynamicDoubleHashTable<int, int> table(17);
+    for (int i = 0; i < 1000; ++i)
+        assert(table.insert(i, -i));
+    assert(table.size() == 2729);
+    int val;
+    for (int i = 0; i < 1000; ++i) {
+        assert(table.search(i, val));
+        assert(val == -i);
+    }
+}
+
+// Pow2Sizing với trần nhỏ để thử bảng động khi không còn kích thước lớn hơn
+struct CappedPow2Sizing : Pow2Sizing {
+    static constexpr int MAX_TABLE_SIZE = 64;
+
+    bool grow(long long n) {
+        Pow2Sizing::grow(std::min<long long>(n, MAX_TABLE_SIZE));
+        return n <= MAX_TABLE_SIZE;
+    }
+};
+
+void testPow2Sizing() {
+    // Bước nhảy lẻ phải đi qua mọi slot: bảng 64 slot chứa được đúng 64 key
+    DoubleHashTable<int, int, AoSSlots, Pow2Sizing> table(50);
+    for (int i = 0; i < 64; ++i)
+        assert(table.insert(i * 64, i));
+    assert(table.isFull());
+    assert(!table.insert(100000, 1));
+
+    int val;
+    for (int i = 0; i < 64; ++i) {
+        assert(table.search(i * 64, val));
+        assert(val == i);
+    }
+
+    DynamicDoubleHashTable<int, int, AoSSlots, Pow2Sizing> dyn(17);
+    for (int i = 0; i < 500; ++i)
+        assert(dyn.insert(i, i));
+    assert(dyn.size() == 1024);
+    assert(dyn.search(499, val) && val == 499);
+
+    Pow2Sizing sz;
+    assert(sz.grow(1 << 20) && sz.TABLE_SIZE == 1 << 20);
+    assert(!sz.grow(1LL << 31) && sz.TABLE_SIZE == Pow2Sizing::MAX_TABLE_SIZE);
+
+    // Tới trần thì ngừng lớn: dùng hết slot rồi insert key mới thất bại, cập nhật vẫn được
+    for (bool incremental : { false, true }) {
+        OpenAddressTable<int, int, DoubleProbe, LoadFactorGrowth, HashStats, AoSSlots, CappedPow2Sizing> capped(8, incremental);
+        for (int i = 0; i < 64; ++i)
+            assert(capped.insert(i, i));
+        assert(capped.size() == 64);
+        assert(!capped.insert(64, 64));
+        assert(capped.insert(5, 50));
+        assert(capped.search(5, val) && val == 50);
+        capped.erase(0);
+        assert(capped.insert(64, 64));
+        assert(capped.size() == 64);
+    }
+}
+
+void testHashPolicies() {
+    DoubleHashTable<std::string, int> table(101);
+    for (int i = 0; i < 60; ++i)
+        assert(table.insert("key-" + std::to_string(i), i));
+    int val;
+    assert(table.search("key-42", val));
+    assert(val == 42);
+    assert(!table.search("key-60", val));
+
+    // Hai nửa của MixHash phải khác nhau với key liên tiếp
+    HashUtils::MixHash<int> mix;
+    assert(helper::lo32(mix(1)) != helper::lo32(mix(2)));
+    assert(helper::hi32(mix(1)) != helper::hi32(mix(2)));
+    assert(mix(7) == mix(7));
+
+    // StdHash giữ nguyên hành vi h % TABLE_SIZE của std::hash
+    LinearHashTable<int, int, HashUtils::StdHash<int>> legacy(7);
+    assert(legacy.hash(8) == 1);
+    assert(legacy.insert(1, 10));
+    assert(legacy.insert(8, 20));
+    assert(legacy.search(8, val));
+    assert(val == 20);
+}
+
+// Xoá/cập nhật key ngay giữa migration: bản đã chuyển sang bảng mới không được sống lại từ bảng cũ
+template<typename Table>
+void checkMigrationErase(Table& table) {
+    int val = 0;
+    int n = 0;
+    while (!table.isMigrating()) {
+        assert(table.insert(n, n));
+        ++n;
+    }
+    bool sawMigration = false;
+    for (int i = 0; i < n; ++i) {
+        sawMigration = sawMigration || table.isMigrating();
+        if (i % 2 == 0) {
+            table.erase(i);
+            assert(!table.search(i, val));
+        }
+        else {
+            assert(table.insert(i, -i));
+            assert(table.search(i, val) && val == -i);
+        }
+    }
+    assert(sawMigration);
+    table.finishRehash();
+    for (int i = 0; i < n; ++i) {
+        assert(table.search(i, val) == (i % 2 == 1));
+        if (i % 2 == 1)
+            assert(val == -i);
+    }
+    assert(int(table.loadFactor() * table.size() + 0.5) == n / 2);
+}
+
+void testIncrementalRehash() {
+    DynamicDoubleHashTable<int, int> table(17, true);
+    std::unordered_map<int, int> expected;
+    int val;
+    bool sawMigration = false;
+    for (int i = 0; i < 2000; ++i) {
+        assert(table.insert(i, i));
+        expected[i] = i;
+        sawMigration = sawMigration || table.isMigrating();
+        // Cập nhật key cũ trong lúc bảng cũ và mới cùng tồn tại
+        if (i % 7 == 0) {
+            assert(table.insert(i / 2, -i));
+            expected[i / 2] = -i;
+        }
+    }
+    for (int i = 0; i < 2000; i += 11) {
+        table.erase(i);
+        expected.erase(i);
+    }
+    assert(sawMigration);
+    assert(table.stats.nResize > 0);
+    for (int i = 0; i < 2000; ++i) {
+        auto it = expected.find(i);
+        assert(table.search(i, val) == (it != expected.end()));
+        if (it != expected.end())
+            assert(val == it->second);
+    }
+    table.finishRehash();
+    assert(!table.isMigrating());
+    assert(table.search(1999, val) && val == 1999);
+
+    DynamicDoubleHashTable<int, int> midMigration(1000, true);
+    checkMigrationErase(midMigration);
+    // Migration nằm trong OpenAddressTable nên mọi probe policy dùng chung một đường
+    OpenAddressTable<int, int, QuadraticProbe, LoadFactorGrowth> quadMigration(1000, true);
+    checkMigrationErase(quadMigration);
+    OpenAddressTable<int, int, LinearProbe, LoadFactorGrowth, HashStats, SoASlots, Pow2Sizing> linearMigration(500, true);
+    checkMigrationErase(linearMigration);
+}
+
+// Cập nhật key nằm sau tombstone không được tạo bản sao; compact() giữ nguyên dữ liệu
+template<typename Table>
+void checkTombstones(Table& table) {
+    int val;
+    for (int i = 0; i < 60; ++i)
+        assert(table.insert(i, i));
+    for (int i = 0; i < 20; ++i)
+        table.erase(i);
+    assert(table.tombstoneCount() == 20);
+    for (int i = 20; i < 60; ++i)
+        assert(table.insert(i, -i));
+    for (int i = 20; i < 60; i += 2)
+        table.erase(i);
+    for (int i = 0; i < 60; ++i)
+        assert(table.search(i, val) == (i >= 20 && i % 2 == 1));
+    table.compact();
+    assert(table.tombstoneCount() == 0);
+    assert(table.usedLoadFactor() == table.loadFactor());
+    for (int i = 0; i < 60; ++i) {
+        assert(table.search(i, val) == (i >= 20 && i % 2 == 1));
+        if (i >= 20 && i % 2 == 1)
+            assert(val == -i);
+    }
+}
+
+void testTombstones() {
+    DoubleHashTable<int, int> dht(211);
+    checkTombstones(dht);
+    DoubleHashTable<int, int, SoASlots> sdt(211);
+    checkTombstones(sdt);
+    LinearHashTable<int, int> lpt(211);
+    checkTombstones(lpt);
+    QuadraticHashTable<int, int> qpt(211);
+    checkTombstones(qpt);
+
+    GroupDoubleHashTable<int, int> gdt(64);
+    int val;
+    for (int i = 0; i < 60; ++i)
+        assert(gdt.insert(i, i));
+    for (int i = 0; i < 60; i += 3)
+        gdt.erase(i);
+    gdt.compact();
+    assert(gdt.tombstoneCount() == 0);
+    for (int i = 0; i < 60; ++i)
+        assert(gdt.search(i, val) == (i % 3 != 0));
+
+    // Churn: số key không đổi, bảng động không được phình ra vì tombstone
+    DynamicDoubleHashTable<int, int> table(101);
+    const int initialSize = table.size();
+    for (int i = 0; i < 50; ++i)
+        table.insert(i, i);
+    for (int i = 50; i < 20000; ++i) {
+        table.erase(i - 50);
+        table.insert(i, i);
+    }
+    assert(table.size() == initialSize);
+    assert(table.usedLoadFactor() <= 0.7 + 1.0 / initialSize);
+    assert(table.stats.nCompact > 0);
+    for (int i = 19950; i < 20000; ++i)
+        assert(table.search(i, val) && val == i);
+    assert(!table.search(0, val));
+
+    // Double hashing ở kích thước hợp số không phủ hết bảng: compact() phải dựng lại ngoài chỗ
+    // (ở load cao một số insert có thể thất bại vì dãy probe quá ngắn)
+    DoubleHashTable<int, int> composite(4096);
+    std::vector<bool> inserted(3686);
+    for (int i = 0; i < 3686; ++i)
+        inserted[i] = composite.insert(i, i);
+    for (int i = 0; i < 3686; i += 3)
+        composite.erase(i);
+    composite.compact();
+    for (int i = 0; i < 3686; ++i) {
+        bool present = composite.search(i, val);
+        assert(present == (inserted[i] && i % 3 != 0));
+        if (present)
+            assert(val == i);
+    }
+
+    // Churn nặng về erase trên bảng double hashing tĩnh cỡ hợp số (7281 = 3^2 * 809), như
+    // pha erase của cache-sweep: mọi lần compact tự động phải giữ đúng nội dung
+    DoubleHashTable<int, int, SoASlots> churn(7281);
+    std::unordered_map<int, int> churnRef;
+    std::mt19937 churnRng(11);
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 6552; ++i) {
+            int key = 2 * i + 1 + round;
+            if (churn.insert(key, i))
+                churnRef[key] = i;
+        }
+        for (int step = 0; step < 20000; ++step) {
+            int key = static_cast<int>(churnRng() % 14000);
+            if (churnRng() % 4 == 0) {
+                if (churn.insert(key, -step))
+                    churnRef[key] = -step;
+            }
+            else {
+                churn.erase(key);
+                churnRef.erase(key);
+            }
+        }
+        for (int key = 0; key < 14000; ++key) {
+            auto it = churnRef.find(key);
+            assert(churn.search(key, val) == (it != churnRef.end()));
+            if (it != churnRef.end())
+                assert(val == it->second);
+        }
+    }
+    assert(churn.stats.nCompact > 0);
+
+    // Quadratic probing ở kích thước không nguyên tố không đi qua mọi slot:
+    // compact() sau erase phải dừng và không làm mất key
+    QuadraticHashTable<int, int> qsmall(64);
+    std::unordered_map<int, int> ref;
+    std::mt19937 rng(7);
+    for (int step = 0; step < 20000; ++step) {
+        int key = static_cast<int>(rng() % 100);
+        if (rng() % 10 < 6) {
+            if (qsmall.insert(key, step))
+                ref[key] = step;
+        }
+        else {
+            qsmall.erase(key);
+            ref.erase(key);
+        }
+    }
+    for (int key = 0; key < 100; ++key) {
+        auto it = ref.find(key);
+        assert(qsmall.search(key, val) == (it != ref.end()));
+        if (it != ref.end())
+            assert(val == it->second);
+    }
+}
+
+// search_batch / insert_batch phải cho cùng kết quả với API từng key
+template<typename Table>
+void checkBatch(Table& table) {
+    std::vector<int> keys, values;
+    for (int i = 0; i < 500; ++i) {
+        keys.push_back(i * 3);
+        values.push_back(i);
+    }
+    assert(table.insert_batch(keys, values) == 500);
+
+    std::vector<int> queries;
+    for (int i = 0; i < 1600; ++i)
+        queries.push_back(i);
+    std::vector<int> out;
+    std::vector<bool> found;
+    table.search_batch(queries, out, found);
+    assert(out.size() == queries.size() && found.size() == queries.size());
+    for (int i = 0; i < 1600; ++i) {
+        int val = 0;
+        assert(found[i] == table.search(i, val));
+        assert(found[i] == (i % 3 == 0 && i < 1500));
+        if (found[i])
+            assert(out[i] == val && val == i / 3);
+    }
+}
+
+void testBatchApi() {
+    DoubleHashTable<int, int> dht(1009);
+    checkBatch(dht);
+    DoubleHashTable<int, int, SoASlots, Pow2Sizing> pdt(1024);
+    checkBatch(pdt);
+    DynamicDoubleHashTable<int, int> ddt(17);
+    checkBatch(ddt);
+    DynamicDoubleHashTable<int, int> idt(17, true);
+    checkBatch(idt);
+
+    std::vector<int> empty, out;
+    std::vector<bool> found;
+    dht.search_batch(empty, out, found);
+    assert(out.empty() && found.empty());
+}
+
+void testInterleavedLookup() {
+    DoubleHashTable<int, int> table(1009);
+    for (int i = 0; i < 700; ++i)
+        assert(table.insert(i * 2, i));
+    // Tombstone nằm giữa chuỗi probe không được làm lane dừng sớm
+    for (int i = 0; i < 700; i += 5)
+        table.erase(i * 2);
+
+    std::vector<int> queries;
+    for (int i = 0; i < 1500; ++i)
+        queries.push_back(i);
+    for (int lanes : { 1, 3, 16, 64 }) {
+        std::vector<int> out;
+        std::vector<bool> found;
+        table.search_interleaved(queries, out, found, lanes);
+        assert(out.size() == queries.size() && found.size() == queries.size());
+        for (int i = 0; i < 1500; ++i) {
+            int val = 0;
+            assert(found[i] == table.search(i, val));
+            if (found[i])
+                assert(out[i] == val && val == i / 2);
+        }
+    }
+
+    std::vector<int> empty, out;
+    std::vector<bool> found;
+    table.search_interleaved(empty, out, found);
+    assert(out.empty() && found.empty());
+}
+
+void testConcurrentDoubleHashTable() {
+    constexpr int THREADS = 4;
+    constexpr int KEYS = 4000;
+    ConcurrentDoubleHashTable<int, int> table(10007);
+
+    // Mọi thread cùng chèn toàn bộ key: mỗi key chỉ được chiếm đúng một slot
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([&table] {
+            for (int i = 0; i < KEYS; ++i)
+                assert(table.insert(i, i * 10));
+        });
+    }
+    for (auto& w : workers) w.join();
+    workers.clear();
+    assert(int(table.loadFactor() * table.size() + 0.5) == KEYS);
+    assert(table.tombstoneCount() == 0);
+    assert(table.stats.snapshot().nInsert == KEYS);
+
+    // Xoá key chẵn, hồi sinh một phần trong khi các thread khác đọc
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([&table, t] {
+            int val;
+            for (int i = t; i < KEYS; i += THREADS) {
+                if (i % 2 == 0) table.erase(i);
+                if (i % 6 == 0) table.insert(i, -i);
+                if (table.search(i + 1, val))
+                    assert(val == (i + 1) * 10 || val == -(i + 1));
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    workers.clear();
+
+    int val;
+    for (int i = 0; i < KEYS; ++i) {
+        bool expectFound = i % 2 == 1 || i % 6 == 0;
+        assert(table.search(i, val) == expectFound);
+        if (expectFound)
+            assert(val == (i % 6 == 0 ? -i : i * 10));
+    }
+    // Tombstone hồi sinh không tốn slot mới
+    assert(int(table.usedLoadFactor() * table.size() + 0.5) == KEYS);
+    assert(!table.search(KEYS + 1, val));
+    assert(table.stats.snapshot().nSearch > 0);
+
+    // Churn với key luôn mới: tombstone phải được dọn, nếu không bảng đầy dù chỉ còn ít key sống
+    ConcurrentDoubleHashTable<int, int> churn(1009);
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([&churn, t] {
+            int v;
+            for (int i = 0; i < 20000; ++i) {
+                int key = (i * THREADS + t) * 2;
+                assert(churn.insert(key, i));
+                assert(churn.search(key, v) && v == i);
+                if (i >= 50)
+                    churn.erase(key - 100 * THREADS);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    workers.clear();
+    assert(churn.stats.snapshot().nCompact > 0);
+    assert(churn.tombstoneCount() <= TombstoneUtils::MAX_TOMBSTONE_RATIO * churn.size() + THREADS);
+    for (int t = 0; t < THREADS; ++t) {
+        for (int i = 19950; i < 20000; ++i)
+            assert(churn.search((i * THREADS + t) * 2, val) && val == i);
+        assert(!churn.search(t * 2, val));
+    }
+
+    // Kích thước hợp số được làm tròn lên một bậc: churn đơn luồng không kẹt trong compact()
+    ConcurrentDoubleHashTable<int, int> small(60);
+    assert(small.size() >= 60 && helper::isPrime(small.size()));
+    for (int i = 0; i < 2000; ++i) {
+        assert(small.insert(i, i));
+        if (i >= 48)
+            small.erase(i - 48);
+    }
+    for (int i = 1952; i < 2000; ++i)
+        assert(small.search(i, val) && val == i);
+    assert(!small.search(1951, val));
+    assert(small.stats.snapshot().nCompact > 0);
+
+    // NoStats: cùng bảng, không đếm gì
+    ConcurrentDoubleHashTable<int, int, PrimeSizing, HashUtils::MixHash<int>, NoStats> quiet(101);
+    assert(quiet.insert(1, 10));
+    assert(quiet.search(1, val) && val == 10);
+    assert(quiet.stats.snapshot().nInsert == 0);
+}
+
+void testRcuDynamicDoubleHashTable() {
+    RcuDynamicDoubleHashTable<int, int> table(17);
+    const int initialSize = table.size();
+    int val;
+
+    // Reader đọc liên tục các key đã có trong lúc writer làm bảng nhân đôi nhiều lần
+    for (int i = 0; i < 100; ++i)
+        table.insert(i, i);
+    std::atomic<bool> done{ false };
+    std::thread reader([&] {
+        int v;
+        while (!done.load()) {
+            for (int i = 0; i < 100; ++i)
+                assert(table.search(i, v) && v == i);
+            // size()/loadFactor() cũng đọc mảng hiện tại trong lúc writer giải phóng mảng cũ
+            assert(table.size() >= initialSize && table.loadFactor() > 0);
+        }
+    });
+    for (int i = 100; i < 20000; ++i)
+        table.insert(i, i);
+    done.store(true);
+    reader.join();
+
+    assert(table.size() > initialSize);
+    assert(table.stats.nResize > 0);
+    assert(table.stats.snapshot().nResize == table.stats.nResize);
+    assert(table.pendingReclaim() == 0);
+    for (int i = 0; i < 20000; ++i)
+        assert(table.search(i, val) && val == i);
+
+    // Update, erase và hồi sinh tombstone
+    for (int i = 0; i < 20000; i += 2)
+        table.erase(i);
+    for (int i = 0; i < 20000; i += 4)
+        table.insert(i, -i);
+    for (int i = 0; i < 20000; ++i) {
+        bool expectFound = i % 2 == 1 || i % 4 == 0;
+        assert(table.search(i, val) == expectFound);
+        if (expectFound)
+            assert(val == (i % 4 == 0 ? -i : i));
+    }
+    assert(!table.search(-1, val));
+
+    // Tới trần kích thước: không dựng lại mảng mỗi lần insert, insert thất bại khi hết slot
+    RcuDynamicDoubleHashTable<int, int, CappedPow2Sizing> capped(8);
+    for (int i = 0; i < 64; ++i)
+        assert(capped.insert(i, i));
+    assert(!capped.insert(64, 64));
+    assert(capped.size() == 64);
+    assert(capped.stats.nResize == 3);
+    assert(capped.search(63, val) && val == 63);
+}
+
+void testShardedHashTable() {
+    ShardedHashTable<int, int> table(6, 64, 4);
+    assert(table.shardCount() == 8);
+
+    std::vector<int> keys, values;
+    for (int i = 0; i < 20000; ++i) {
+        keys.push_back(i);
+        values.push_back(i * 3);
+    }
+    assert(table.insert_bulk(keys, values) == 20000);
+
+    // Key được rải đều: mọi shard đều phải tự rehash
+    for (int s = 0; s < table.shardCount(); ++s)
+        assert(table.shardSize(s) > 64 / 8);
+
+    std::vector<int> queries;
+    for (int i = 0; i < 25000; ++i)
+        queries.push_back(i);
+    std::vector<int> out;
+    std::vector<bool> found;
+    table.search_bulk(queries, out, found);
+    for (int i = 0; i < 25000; ++i) {
+        assert(found[i] == (i < 20000));
+        if (found[i])
+            assert(out[i] == i * 3);
+    }
+
+    std::vector<int> evens;
+    for (int i = 0; i < 20000; i += 2)
+        evens.push_back(i);
+    table.erase_bulk(evens);
+    int val;
+    for (int i = 0; i < 20000; ++i)
+        assert(table.search(i, val) == (i % 2 == 1));
+
+    HashStats total = table.aggregateStats();
+    assert(total.nInsert >= 20000);  // rehash chèn lại qua insert() nên cũng được đếm
+    assert(total.nSearch == 25000 + 20000);
+    assert(total.nDelete == 10000);
+    assert(table.loadFactor() > 0 && table.loadFactor() <= 0.7);
+
+    ShardedHashTable<int, int> single(1, 101, 1);
+    assert(single.shardCount() == 1);
+    assert(single.insert(5, 50) && single.search(5, val) && val == 50);
+}
+
+void testSeededWorkload() {
+    // Cùng seed phải sinh ra đúng cùng workload để các lần chạy so sánh được với nhau
+    BenchmarkUtils::generator::setSeed(7);
+    auto a = BenchmarkUtils::makeWorkload(1, 1000, 0.5, 100000);
+    BenchmarkUtils::generator::setSeed(7);
+    auto b = BenchmarkUtils::makeWorkload(1, 1000, 0.5, 100000);
+    assert(a.keyvals == b.keyvals);
+    assert(a.search_hit_indices == b.search_hit_indices);
+    assert(a.search_miss_keys == b.search_miss_keys);
+    assert(a.delete_indices == b.delete_indices);
+    assert(a.patternName == "RANDOM");
+
+    BenchmarkUtils::generator::setSeed(8);
+    auto c = BenchmarkUtils::makeWorkload(1, 1000, 0.5, 100000);
+    assert(a.keyvals != c.keyvals);
+    BenchmarkUtils::generator::setSeed(BenchmarkUtils::generator::DEFAULT_SEED);
+}
+
+void testMeasureSummary() {
+    auto ps = BenchmarkUtils::measure::summarize({ 400, 100, 300, 200 }, 10);
+    assert(ps.samples == 4);
+    assert(ps.minNs == 100);
+    assert(ps.medianNs == 250);
+    assert(ps.meanNs == 250);
+    assert(ps.nsPerOp == 25);
+    assert(ps.stddevNs > 129 && ps.stddevNs < 130);
+    assert(ps.ci95Ns > ps.stddevNs);  // n = 4: t(3) / sqrt(4) > 1
+
+    // Các mẫu bằng nhau hội tụ ngay sau minReps lần đo
+    BenchmarkUtils::measure::Config cfg;
+    cfg.warmup = 0;
+    cfg.minReps = 3;
+    cfg.maxReps = 10;
+    assert(!BenchmarkUtils::measure::converged({ 5, 5 }, cfg));
+    assert(BenchmarkUtils::measure::converged({ 5, 5, 5 }, cfg));
+
+    // Chỉ chọn bên thắng khi khoảng tin cậy không chồng lên nhau
+    auto fast = BenchmarkUtils::measure::summarize({ 100, 101, 99, 100 }, 10);
+    auto slow = BenchmarkUtils::measure::summarize({ 200, 202, 198, 200 }, 10);
+    assert(BenchmarkUtils::fasterWithCI(fast, slow));
+    assert(!BenchmarkUtils::fasterWithCI(slow, fast));
+    assert(!BenchmarkUtils::fasterWithCI(ps, fast) && !BenchmarkUtils::fasterWithCI(fast, ps));
+
+    // testTable đo đủ số lần và điền thời gian cho mọi pha
+    DoubleHashTable<int, int> table(211);
+    std::vector<std::pair<int, int>> keyvals;
+    std::vector<int> hit, miss, del;
+    for (int i = 0; i < 100; ++i) {
+        keyvals.push_back({ i * 7 + 1, i });
+        hit.push_back(i);
+        del.push_back(i);
+        miss.push_back(100000 + i);
+    }
+    auto res = BenchmarkUtils::testTable(table, keyvals, hit, miss, del, cfg);
+    assert(res.runs >= cfg.minReps && res.runs <= cfg.maxReps);
+    assert(res.insertAfterDeletePhase.samples == res.runs);
+    assert(res.searchHitPhase.ops == 100);
+    assert(res.avgProbeSearchHit >= 1);
+}
+
+void testHistograms() {
+    LogHistogram h;
+    for (uint64_t v = 1; v <= 1000; ++v)
+        h.record(v);
+    assert(h.count() == 1000);
+    assert(h.min() == 1 && h.max() == 1000);
+    // Sai số tương đối của bucket <= 1/16
+    assert(h.percentile(50) >= 500 && h.percentile(50) <= 500 + 500 / 16);
+    assert(h.percentile(99) >= 990 && h.percentile(99) <= 1000);
+    assert(h.percentile(100) == 1000);
+    for (uint64_t v : std::initializer_list<uint64_t>{ 0, 31, 32, 1000, 123456789, UINT64_MAX }) {
+        int b = LogHistogram::bucketOf(v);
+        assert(b >= 0 && b < LogHistogram::BUCKETS);
+        assert(LogHistogram::bucketHigh(b) >= v);
+    }
+
+    LogHistogram other;
+    other.record(5000, 10);
+    h.merge(other);
+    assert(h.count() == 1010 && h.max() == 5000);
+
+    // Bảng chưa bật histogram thì không ghi gì
+    DoubleHashTable<int, int> plain(101);
+    plain.insert(1, 1);
+    assert(!plain.stats.hist);
+
+    // Đếm đúng số thao tác theo từng loại; insert lồng trong rehash không tính là insert
+    DynamicDoubleHashTable<int, int> table(17);
+    table.stats.enableHistograms();
+    int val;
+    for (int i = 0; i < 1000; ++i)
+        table.insert(i, i);
+    for (int i = 0; i < 300; ++i)
+        table.search(i, val);
+    for (int i = 0; i < 200; ++i)
+        table.search(100000 + i, val);
+    for (int i = 0; i < 100; ++i)
+        table.erase(i);
+    const OpHistograms& hist = *table.stats.hist;
+    assert(hist.latency[HIST_INSERT].count() == 1000);
+    assert(hist.latency[HIST_SEARCH_HIT].count() == 300);
+    assert(hist.latency[HIST_SEARCH_MISS].count() == 200);
+    assert(hist.latency[HIST_ERASE].count() == 100);
+    assert(hist.latency[HIST_REHASH].count() > 0);
+    assert(hist.probes[HIST_SEARCH_HIT].min() >= 1);
+    assert(hist.depth == 0);
+
+    // Shard gộp histogram qua aggregateStats
+    ShardedHashTable<int, int> sharded(4, 64, 2);
+    sharded.enableHistograms();
+    for (int i = 0; i < 500; ++i)
+        sharded.insert(i, i);
+    HashStats total = sharded.aggregateStats();
+    assert(total.hist && total.hist->latency[HIST_INSERT].count() == 500);
+}
+
+void testPerfCounters() {
+    PerfCounts acc;
+    assert(!acc.valid(PERF_CYCLES) && acc.perOp(PERF_CYCLES) < 0);
+
+    PerfCounts sample;
+    sample.value[PERF_CYCLES] = 1000;
+    acc.add(sample, 10);
+    acc.add(sample, 10);
+    assert(acc.valid(PERF_CYCLES) && acc.perOp(PERF_CYCLES) == 100);
+    assert(!acc.valid(PERF_LLC_MISSES));  // event không đọc được vẫn là -1
+
+    // Máy không có PMU hoặc không đủ quyền: đo vẫn chạy, bộ đếm báo -1
+    auto& counters = BenchmarkUtils::perf::counters();
+    counters.start();
+    PerfCounts got = counters.stop();
+    if (!counters.available()) {
+        assert(!counters.unavailableReason().empty());
+        for (int e = 0; e < PERF_EVENT_COUNT; ++e)
+            assert(got.value[e] == -1);
+    }
+}
+
+void testStatsPolicies() {
+    // NoStats: bảng vẫn đúng, mọi bộ đếm luôn bằng 0
+    DoubleHashTable<int, int, AoSSlots, PrimeSizing, HashUtils::MixHash<int>, NoStats> quiet(101);
+    int val;
+    for (int i = 0; i < 50; ++i)
+        assert(quiet.insert(i, i * 2));
+    assert(quiet.search(7, val) && val == 14);
+    quiet.erase(7);
+    assert(!quiet.search(7, val));
+    assert(quiet.stats.nInsert == 0 && quiet.stats.totalProbesSearch == 0);
+    static_assert(!NoStats::ENABLED && HashStats::ENABLED && ShardedStats::ENABLED);
+
+    // ShardedStats: nhiều reader cùng search dưới shared lock, tổng đếm không mất lần nào
+    DynamicDoubleHashTable<int, int, AoSSlots, PrimeSizing, HashUtils::MixHash<int>, ShardedStats> table(17);
+    for (int i = 0; i < 1000; ++i)
+        table.insert(i, i);
+    std::shared_mutex rw;
+    constexpr int THREADS = 4, LOOKUPS = 5000;
+    std::vector<std::thread> readers;
+    for (int t = 0; t < THREADS; ++t) {
+        readers.emplace_back([&, t] {
+            int v;
+            for (int i = 0; i < LOOKUPS; ++i) {
+                std::shared_lock<std::shared_mutex> lock(rw);
+                table.search((i * 7 + t) % 1000, v);
+            }
+        });
+    }
+    for (auto& r : readers) r.join();
+    assert(table.stats.nSearch == THREADS * LOOKUPS);
+    assert(table.stats.nInsert >= 1000);
+
+    // snapshot() và bản sao giữ nguyên giá trị
+    HashStats snap = table.stats.snapshot();
+    assert(snap.nSearch == THREADS * LOOKUPS);
+    auto copy = table;
+    assert(copy.stats.nSearch == THREADS * LOOKUPS);
+}
+
 int main() {
     std::cout << "Running unit tests...\n";
     testDoubleHashTable();
     testLinearHashTable();
     testQuadraticHashTable();
+    testSoADoubleHashTable();
+    testGroupDoubleHashTable();
+    testOpenAddressPolicies();
+    testRobinHoodHashTable();
+    testCuckooHashTable();
+    testHopscotchHashTable();
+    testBucketDoubleHashTable();
+    testFastMod();
+    testPrimeLadder();
+    testPow2Sizing();
+    testHashPolicies();
+    testIncrementalRehash();
+    testTombstones();
+    testBatchApi();
+    testInterleavedLookup();
+    testConcurrentDoubleHashTable();
+    testRcuDynamicDoubleHashTable();
+    testShardedHashTable();
+    testSeededWorkload();
+    testMeasureSummary();
+    testHistograms();
+    testPerfCounters();
+    testStatsPolicies();
     std::cout << "All tests passed!\n";
     return 0;
 }